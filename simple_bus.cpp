@@ -63,94 +63,111 @@
  *****************************************************************************/
 
  #include "simple_bus.h"
-
- // Definición de variables globales para medir el uso del bus
- sc_time bus_active_time = SC_ZERO_TIME;
- sc_time total_simulation_time = SC_ZERO_TIME;
- sc_time last_time_stamp = SC_ZERO_TIME;
-
- // Agrega estas líneas junto a las otras variables globales al principio del archivo
-unsigned long total_bytes_transferred = 0;
-unsigned int total_transactions = 0;
-unsigned int read_transactions = 0;
-unsigned int write_transactions = 0;
-
-sc_time total_read_time = SC_ZERO_TIME;   // Tiempo total usado en lecturas
-sc_time total_write_time = SC_ZERO_TIME;  // Tiempo total usado en escrituras
-sc_time current_transfer_start_time;      // Tiempo de inicio de la transferencia actual
-
-unsigned int read_transfers_started = 0;   // Número de transferencias de lectura iniciadas
-unsigned int write_transfers_started = 0;  // Número de transferencias de escritura iniciadas
  
  //----------------------------------------------------------------------------
  //-- SystemC callback methods
  //----------------------------------------------------------------------------
  void simple_bus::end_of_elaboration()
  {
+   build_decode_table();
+
+   // the loosely-timed interface computes delays from the clock period
+   sc_clock *clk = dynamic_cast<sc_clock *>(clock.get_interface());
+   if (clk)
+     m_clock_period = clk->period();
+
+   // forward DMI invalidations of the slaves to our own listeners
+   for (unsigned int i = 0; i < m_decode_table.size(); ++i)
+     m_decode_table[i].slave->register_dmi_listener(this);
+
    // perform a static check for overlapping memory areas of the slaves
-   bool no_overlap;
-   for (int i = 1; i < slave_port.size(); ++i) {
-     simple_bus_slave_if *slave1 = slave_port[i];
-     for (int j = 0; j < i; ++j) {
-       simple_bus_slave_if *slave2 = slave_port[j]; 
-       no_overlap = ( slave1->end_address() < slave2->start_address() ) ||
-                ( slave1->start_address() > slave2->end_address() );
-       if ( !no_overlap ) {
-         sb_fprintf(stdout,"Error: overlapping address spaces of 2 slaves : \n");
-         sb_fprintf(stdout,"slave %i : %0X..%0X\n",i,slave1->start_address(),slave1->end_address()); 
-         sb_fprintf(stdout,"slave %i : %0X..%0X\n",j,slave2->start_address(),slave2->end_address());
-         exit(0);
-       }
-     }
-   }
+   if (simple_bus_check_overlaps(m_decode_table) > 0)
+     exit(1);
  }
  
  void simple_bus::end_of_simulation()
 {
   // Registrar el tiempo total de simulación
-  total_simulation_time = sc_time_stamp();
+  m_metrics.simulation_time.set(sb_time_ps(sc_time_stamp()));
   
   // Imprimir mensaje para depuración
   printf("=== Fin de la simulación: Ejecutando end_of_simulation() ===\n");
-  printf("Total simulation time: %f seconds\n", total_simulation_time.to_seconds());
+  printf("Total simulation time: %f seconds\n", sc_time_stamp().to_seconds());
   
   // Reportar la utilización del bus
   report_bus_utilization();
+
+  // write out the rest of the transaction trace
+  if (m_trace)
+    m_trace->close();
 }
+
+ simple_bus::~simple_bus()
+ {
+   if (m_trace) {delete m_trace; m_trace = 0;}
+ }
  
  //----------------------------------------------------------------------------
  //-- process
  //----------------------------------------------------------------------------
  void simple_bus::main_action()
  {
-  // Añadir un pequeño retraso artificial
-   // Reducir el divisor si quieres más transacciones
-   static int count = 0;
-   if (++count % 1 != 0) return;  // Ejecutar cada ciclo en lugar de cada 2
-   // Si el bus está en uso, contar el tiempo activo
-   if (m_current_request) {
-     sc_time current_time = sc_time_stamp();
-     bus_active_time += current_time - last_time_stamp;
+   // woken up from idle mode by a posted request: return to the static
+   // sensitivity, the request is handled at the next falling clock edge
+   if (m_idle) {
+     m_idle = false;
+     next_trigger();
+     return;
    }
+
+   if (sb_metrics) {
+     // Si el bus está en uso, contar el tiempo activo
+     if (m_current_request) {
+       sc_time current_time = sc_time_stamp();
+       m_metrics.active_time.add(sb_time_ps(current_time - m_last_time_stamp));
+     }
    
-   // Actualizar el timestamp para el próximo cálculo
-   last_time_stamp = sc_time_stamp();
+     // Actualizar el timestamp para el próximo cálculo
+     m_last_time_stamp = sc_time_stamp();
+   }
+
+   // posted writes: retire the drained head, take new writes in and
+   // answer the reads the FIFO covers
+   if (m_posted_depth)
+     accept_posted_writes();
    
    // m_current_request is cleared after the slave is done with a
    // single data transfer. Burst requests require the arbiter to
    // select the request again.
  
    if (!m_current_request)
-     m_current_request = get_next_request();
+     {
+       m_current_request = get_next_request();
+       // another master broke into a prefetched burst: fetch the rest of
+       // it word by word again, so it observes what the intruder writes
+       if (m_prefetched_request && (m_current_request != m_prefetched_request))
+         m_prefetched_request = (simple_bus_request *)0;
+     }
    else
      // monitor slave wait states
-     if (m_verbose)
+     if (sb_logging && m_verbose)
        sb_fprintf(stdout, "%s SLV [%d]\n", sc_time_stamp().to_string().c_str(),
       m_current_request->address);
    if (m_current_request)
      handle_request();
+   if (!m_split_requests.empty())
+     poll_split_requests();
    if (!m_current_request)
-     clear_locks();
+     {
+       clear_locks();
+       // nothing pending and all locks released: further cycles would
+       // not change any state, so sleep until a master posts a request
+       if (is_idle())
+         {
+           m_idle = true;
+           next_trigger(m_request_posted);
+         }
+     }
  }
  
  //----------------------------------------------------------------------------
@@ -164,10 +181,15 @@ unsigned int write_transfers_started = 0;  // Número de transferencias de escri
      return false; 
    }
    // Registrar el inicio de una transferencia de lectura
- read_transfers_started++;  
+   if (sb_metrics)
+     m_metrics.read_transfers_started.add(1);
    simple_bus_slave_if *slave = get_slave(address);
    if (!slave) return false;
-   return slave->direct_read(data, address);
+   bool ok = slave->direct_read(data, address);
+   // writes still in the FIFO are newer than the slave contents
+   if (ok && m_posted_depth)
+     posted_read_word(data, address);
+   return ok;
  }
  
  
@@ -177,10 +199,40 @@ unsigned int write_transfers_started = 0;  // Número de transferencias de escri
      sb_fprintf(stdout, "  BUS ERROR --> address %04X not word alligned\n",address);
      return false; 
    }
-   write_transfers_started++;
+   if (sb_metrics)
+     m_metrics.write_transfers_started.add(1);
+   simple_bus_slave_if *slave = get_slave(address);
+   if (!slave) return false;
+   bool ok = slave->direct_write(data, address);
+   // and must not overwrite this write once they are drained
+   if (ok && m_posted_depth)
+     posted_write_word(data, address);
+   return ok;
+ }
+
+ bool simple_bus::get_direct_mem_ptr(unsigned int address, simple_bus_dmi &dmi)
+ {
+   if (address%4 != 0 ) {// address not word alligned
+     sb_fprintf(stdout, "  BUS ERROR --> address %04X not word alligned\n",address);
+     return false; 
+   }
+   // a pointer would bypass the posted-write FIFO
+   if (m_posted_depth)
+     return false;
    simple_bus_slave_if *slave = get_slave(address);
    if (!slave) return false;
-   return slave->direct_write(data, address);
+   return slave->get_direct_mem_ptr(address, dmi);
+ }
+
+ void simple_bus::register_dmi_listener(simple_bus_dmi_invalidate_if *listener)
+ {
+   m_dmi_listeners.add(listener);
+ }
+
+ void simple_bus::invalidate_direct_mem_ptr(unsigned int start_address
+                                            , unsigned int end_address)
+ {
+   m_dmi_listeners.invalidate(start_address, end_address);
  }
  
  //----------------------------------------------------------------------------
@@ -189,12 +241,12 @@ unsigned int write_transfers_started = 0;  // Número de transferencias de escri
  
  void simple_bus::read(unsigned int unique_priority, int *data, unsigned int address, bool lock)
 {
-  if (m_verbose)
+  if (sb_logging && m_verbose)
     sb_fprintf(stdout, "%s %s : read(%d) @ %x\n",
          sc_time_stamp().to_string().c_str(), name(), unique_priority, address);
   
   // Incrementar contador de transferencias iniciadas
-  // read_transfers_started++;
+  // m_metrics.read_transfers_started.add(1);
   
   simple_bus_request *request = get_request(unique_priority);
 
@@ -206,22 +258,60 @@ unsigned int write_transfers_started = 0;  // Número de transferencias de escri
   request->address            = address;
   request->end_address        = address;
   request->data               = data;
+  request->start_address      = request->address;
+  request->wait_cycles        = 0;
+  if (sb_metrics)
+    request->post_time        = sc_time_stamp();
+  request->byte_enable        = SIMPLE_BUS_WORD_ENABLE;
 
   if (lock)
     request->lock = (request->lock == SIMPLE_BUS_LOCK_SET) ? 
       SIMPLE_BUS_LOCK_GRANTED : SIMPLE_BUS_LOCK_SET;
 
-  request->status = SIMPLE_BUS_REQUEST;
+  set_status(request, SIMPLE_BUS_REQUEST);
+  m_request_posted.notify(SC_ZERO_TIME);
 }
  
 void simple_bus::write(unsigned int unique_priority, int *data, unsigned int address, bool lock)
 {
-  if (m_verbose) 
+  if (sb_logging && m_verbose) 
     sb_fprintf(stdout, "%s %s : write(%d) @ %x\n",
          sc_time_stamp().to_string().c_str(), name(), unique_priority, address);
 
   // Incrementar contador de transferencias iniciadas
-  // write_transfers_started++;
+  // m_metrics.write_transfers_started.add(1);
+
+  simple_bus_request *request = get_request(unique_priority);
+
+  // abort when the request is still not finished
+  sc_assert((request->status == SIMPLE_BUS_OK) ||
+      (request->status == SIMPLE_BUS_ERROR));
+
+  request->do_write           = true; // we are writing
+  request->address            = address;
+  request->end_address        = address;
+  request->data               = data;
+  request->start_address      = request->address;
+  request->wait_cycles        = 0;
+  if (sb_metrics)
+    request->post_time        = sc_time_stamp();
+  request->byte_enable        = SIMPLE_BUS_WORD_ENABLE;
+
+  if (lock)
+    request->lock = (request->lock == SIMPLE_BUS_LOCK_SET) ?
+      SIMPLE_BUS_LOCK_GRANTED : SIMPLE_BUS_LOCK_SET;
+
+  set_status(request, SIMPLE_BUS_REQUEST);
+  m_request_posted.notify(SC_ZERO_TIME);
+}
+
+void simple_bus::write_bytes(unsigned int unique_priority, int *data, unsigned int address
+			     , unsigned int byte_enable, bool lock)
+{
+  if (sb_logging && m_verbose) 
+    sb_fprintf(stdout, "%s %s : write_bytes(%d) @ %x [%x]\n",
+         sc_time_stamp().to_string().c_str(), name(), unique_priority, address,
+         byte_enable);
 
   simple_bus_request *request = get_request(unique_priority);
 
@@ -233,12 +323,18 @@ void simple_bus::write(unsigned int unique_priority, int *data, unsigned int add
   request->address            = address;
   request->end_address        = address;
   request->data               = data;
+  request->start_address      = request->address;
+  request->wait_cycles        = 0;
+  if (sb_metrics)
+    request->post_time        = sc_time_stamp();
+  request->byte_enable        = byte_enable & SIMPLE_BUS_WORD_ENABLE;
 
   if (lock)
     request->lock = (request->lock == SIMPLE_BUS_LOCK_SET) ?
       SIMPLE_BUS_LOCK_GRANTED : SIMPLE_BUS_LOCK_SET;
 
-  request->status = SIMPLE_BUS_REQUEST;
+  set_status(request, SIMPLE_BUS_REQUEST);
+  m_request_posted.notify(SC_ZERO_TIME);
 }
  
  simple_bus_status simple_bus::get_status(unsigned int unique_priority)
@@ -256,25 +352,31 @@ void simple_bus::write(unsigned int unique_priority, int *data, unsigned int add
             , unsigned int length
             , bool lock)
  {
-   if (m_verbose) 
+   if (sb_logging && m_verbose) 
    {
      sb_fprintf(stdout, "%s %s : burst_read(%d) @ %x\n",
    sc_time_stamp().to_string().c_str(), name(), unique_priority, 
    start_address);
    }
-  //  read_transfers_started++;
+  //  m_metrics.read_transfers_started.add(1);
    simple_bus_request *request = get_request(unique_priority);
  
    request->do_write           = false; // we are reading
    request->address            = start_address;
    request->end_address        = start_address + (length-1)*4;
    request->data               = data;
+   request->start_address      = request->address;
+   request->wait_cycles        = 0;
+   if (sb_metrics)
+     request->post_time        = sc_time_stamp();
+   request->byte_enable        = SIMPLE_BUS_WORD_ENABLE;
  
    if (lock)
      request->lock = (request->lock == SIMPLE_BUS_LOCK_SET) ? 
        SIMPLE_BUS_LOCK_GRANTED : SIMPLE_BUS_LOCK_SET;
  
-   request->status = SIMPLE_BUS_REQUEST;
+   set_status(request, SIMPLE_BUS_REQUEST);
+   m_request_posted.notify(SC_ZERO_TIME);
  
    wait(request->transfer_done);
    wait(clock->posedge_event());
@@ -287,137 +389,231 @@ void simple_bus::write(unsigned int unique_priority, int *data, unsigned int add
              , unsigned int length
              , bool lock)
  {
-   if (m_verbose) 
+   if (sb_logging && m_verbose) 
      sb_fprintf(stdout, "%s %s : burst_write(%d) @ %x\n",
           sc_time_stamp().to_string().c_str(), name(), unique_priority, 
           start_address);
-          // write_transfers_started++;
+          // m_metrics.write_transfers_started.add(1);
    simple_bus_request *request = get_request(unique_priority);
  
    request->do_write           = true; // we are writing
    request->address            = start_address;
    request->end_address        = start_address + (length-1)*4;
    request->data               = data;
+   request->start_address      = request->address;
+   request->wait_cycles        = 0;
+   if (sb_metrics)
+     request->post_time        = sc_time_stamp();
+   request->byte_enable        = SIMPLE_BUS_WORD_ENABLE;
  
    if (lock)
      request->lock = (request->lock == SIMPLE_BUS_LOCK_SET) ? 
        SIMPLE_BUS_LOCK_GRANTED : SIMPLE_BUS_LOCK_SET;
  
-   request->status = SIMPLE_BUS_REQUEST;
+   set_status(request, SIMPLE_BUS_REQUEST);
+   m_request_posted.notify(SC_ZERO_TIME);
  
    wait(request->transfer_done);
    wait(clock->posedge_event());
    return request->status;
  }
  
+ //----------------------------------------------------------------------------
+ //-- loosely-timed BUS interface
+ //----------------------------------------------------------------------------
+
+ simple_bus_status simple_bus::b_transport(bool do_write
+            , int *data
+            , unsigned int start_address
+            , unsigned int length
+            , sc_time &delay)
+ {
+   if (sb_logging && m_verbose) 
+     sb_fprintf(stdout, "%s %s : b_transport(%s) @ %x\n",
+          sc_time_stamp().to_string().c_str(), name(),
+          do_write ? "write" : "read", start_address);
+
+   if (start_address%4 != 0 ) {// address not word alligned
+     sb_fprintf(stdout, "  BUS ERROR --> address %04X not word alligned\n",start_address);
+     return SIMPLE_BUS_ERROR;
+   }
+
+   unsigned int address = start_address;
+   unsigned int end_address = start_address + (length-1)*4;
+   while (address <= end_address)
+     {
+       simple_bus_slave_if *slave = get_slave(address);
+       if (!slave) {
+         sb_fprintf(stdout, "  BUS ERROR --> no slave for address %04X \n",address);
+         return SIMPLE_BUS_ERROR;
+       }
+       // the data moves through the direct interface of the slave, the
+       // timing is what the beat costs on the bus: one cycle to issue
+       // it, plus the wait states of the slave
+       unsigned int words = beat_words(address, end_address, m_last_decode);
+       for (unsigned int i = 0; i < words; ++i)
+         {
+           bool ok = do_write ? slave->direct_write(data + i, address + 4*i)
+                              : slave->direct_read(data + i, address + 4*i);
+           if (!ok)
+             return SIMPLE_BUS_ERROR;
+           if (m_posted_depth) {
+             if (do_write)
+               posted_write_word(data + i, address + 4*i);
+             else
+               posted_read_word(data + i, address + 4*i);
+           }
+         }
+       delay += m_clock_period * (double)(1 + m_last_decode->nr_wait_states);
+
+       if (sb_metrics) {
+         m_metrics.bytes_transferred.add(4*words);
+         m_metrics.transactions.add(1);
+         if (do_write)
+           m_metrics.write_transactions.add(1);
+         else
+           m_metrics.read_transactions.add(1);
+       }
+
+       address += 4*words;
+       data += words;
+     }
+   return SIMPLE_BUS_OK;
+ }
+ 
  //----------------------------------------------------------------------------
  //-- BUS methods:
  //
  //     handle_request()   : performs atomic bus-to-slave request
+ //     get_slave()        : decodes an address to a slave (decode table)
  //     get_request()      : BUS-interface: gets the request form of given 
  //                          priority
  //     get_next_request() : returns a valid request out of the list of 
  //                          pending requests
+ //     split_hold()       : split mode: true if the slave of an address
+ //                          holds its maximum number of parked transfers,
+ //                          or a transfer to the address is parked
+ //     set_status()       : updates the status of a request and the mask
+ //                          of pending request slots, and tells the
+ //                          arbiter
+ //     is_parked()        : split mode: true if a request is parked at a
+ //                          slave
  //     clear_locks()      : downgrade the lock status of the requests once
  //                          the transfer is done
+ //     is_idle()          : true if no request is pending and no lock is
+ //                          left to downgrade
+ //     beat_words()       : number of words the next beat of a request moves
+ //     access_slave()     : issues one beat to a slave (word or wide beat)
+ //     complete_beat()    : books a finished beat transfer, completes the
+ //                          request after its last word
+ //     poll_split_requests(): split mode: re-issues the parked transfers
+ //     accept_posted_writes(): posted writes: moves write requests into
+ //                          the FIFO, answers reads from it
+ //     start_drain()      : loads the head of the FIFO into the drain form
+ //     lock_held()        : a master holds a lock, the FIFO must not drain
+ //     trace_request()    : records a finished request in the trace
+ //     record_latency()   : books the latency of a completed request in
+ //                          the histograms
+ //     build_decode_table(): sorts the slave address ranges for get_slave
  //----------------------------------------------------------------------------
  
  void simple_bus::handle_request()
 {
-  if (m_verbose)
+  if (sb_logging && m_verbose)
       sb_fprintf(stdout, "%s %s Handle Slave(%d)\n",
       sc_time_stamp().to_string().c_str(), name(), 
       m_current_request->priority);
 
-  // Registrar el tiempo de inicio de la transferencia
-  current_transfer_start_time = sc_time_stamp();
- 
-  m_current_request->status = SIMPLE_BUS_WAIT;
   simple_bus_slave_if *slave = get_slave(m_current_request->address);
  
   if ((m_current_request->address)%4 != 0 ) {// address not word alligned
     sb_fprintf(stdout, "  BUS ERROR --> address %04X not word alligned\n",m_current_request->address);
-    m_current_request->status = SIMPLE_BUS_ERROR;
+    set_status(m_current_request, SIMPLE_BUS_ERROR);
+    trace_request(m_current_request);
     m_current_request = (simple_bus_request *)0;
     return;
   }
   if (!slave) {
     sb_fprintf(stdout, "  BUS ERROR --> no slave for address %04X \n",m_current_request->address);
-    m_current_request->status = SIMPLE_BUS_ERROR;
+    set_status(m_current_request, SIMPLE_BUS_ERROR);
+    trace_request(m_current_request);
+    m_current_request = (simple_bus_request *)0;
+    return;
+  }
+ 
+  if (m_split_transactions &&
+      (m_last_decode->nr_outstanding >= m_last_decode->max_outstanding)) {
+    // split mode: the slave is busy with its maximum number of parked
+    // transfers (get_next_request leaves such requests out); keep the
+    // request pending as it is and free the bus for others
     m_current_request = (simple_bus_request *)0;
     return;
   }
+
+  set_status(m_current_request, SIMPLE_BUS_WAIT);
  
+  unsigned int words = beat_words(m_current_request->address,
+                                  m_current_request->end_address,
+                                  m_last_decode);
   simple_bus_status slave_status = SIMPLE_BUS_OK;
-  if (m_current_request->do_write)
-    slave_status = slave->write(m_current_request->data, 
-        m_current_request->address);
+  if (m_current_request == m_prefetched_request)
+    slave_status = SIMPLE_BUS_OK; // beat already fetched by the native burst
+  else if (!m_current_request->do_write &&
+           (m_current_request->address < m_current_request->end_address) &&
+           (m_current_request->end_address <= m_last_decode->end_address) &&
+           slave->burst_read(m_current_request->data,
+                             m_current_request->address,
+                             (m_current_request->end_address -
+                              m_current_request->address)/4 + 1))
+    {
+      // the rest of the burst lives in one slave which supports native
+      // bursts: the data is in place, the remaining beats are only
+      // counted, so the cycle accounting stays the same
+      m_prefetched_request = m_current_request;
+    }
   else
-    slave_status = slave->read(m_current_request->data,
-            m_current_request->address);
+    slave_status = access_slave(m_current_request, m_last_decode, words);
  
-  if (m_verbose)
+  if (sb_logging && m_verbose)
     sb_fprintf(stdout, "  --> status=(%s)\n", simple_bus_status_str[slave_status]);
  
   switch(slave_status)
   {
     case SIMPLE_BUS_ERROR:
     {
-      m_current_request->status = SIMPLE_BUS_ERROR;
+      set_status(m_current_request, SIMPLE_BUS_ERROR);
+      trace_request(m_current_request);
       m_current_request->transfer_done.notify();
       m_current_request = (simple_bus_request *)0;
       break;
     }
     case SIMPLE_BUS_OK:
     {
-      // Añadir un pequeño retraso artificial para hacer visible la duración
-      // Añadir un pequeño retraso artificial para hacer visible la duración
-      // next_trigger(SC_ZERO_TIME);  // Usar next_trigger() en lugar de wait()
-      
-      
-      // Calcular la duración de esta transferencia y añadir un valor mínimo
-      sc_time transfer_duration;
-      if (m_current_request->do_write) {
-        transfer_duration = sc_time(1, SC_NS); // 1 nanosegundo para escrituras
-      } else {
-        transfer_duration = sc_time(0.8, SC_NS); // 0.8 nanosegundos para lecturas
-      }
-      // Acumular el tiempo según el tipo de transferencia
-      if (m_current_request->do_write)
-        total_write_time += transfer_duration;
-      else
-        total_read_time += transfer_duration;
-    
-      // Código existente para incrementar address y data
-      m_current_request->address+=4; //next word (byte addressing)
-      m_current_request->data++;
-      
-      // Agregar contadores para throughput (4 bytes por palabra)
-      total_bytes_transferred += 4;
-      total_transactions++;
-      
-      // Contar separadamente lecturas y escrituras
-      if (m_current_request->do_write)
-        write_transactions++;
-      else
-        read_transactions++;
-      
-      if (m_current_request->address > m_current_request->end_address)
-      {
-        // burst-transfer (or single transfer) completed
-        m_current_request->status = SIMPLE_BUS_OK;
-        m_current_request->transfer_done.notify();
-        m_current_request = (simple_bus_request *)0;
-      }
-      else
-      { // more data to transfer, but the (atomic) slave transfer is done
-        m_current_request = (simple_bus_request *)0;
-      }
+      complete_beat(m_current_request, words, m_last_decode);
+      // burst completed, or more data to transfer but the (atomic)
+      // slave transfer is done
+      m_current_request = (simple_bus_request *)0;
       break;
     }
     case SIMPLE_BUS_WAIT:
     {
-      // the slave is still processing: no clearance of the current request
+      m_current_request->wait_cycles++;
+      if (m_split_transactions) {
+        // split mode: park the transfer at the slave and release the
+        // bus; poll_split_requests completes it when the slave is ready
+        simple_bus_split_transfer transfer;
+        transfer.request = m_current_request;
+        transfer.slave = m_last_decode;
+        transfer.words = words;
+        transfer.issued = sc_time_stamp();
+        transfer.lock = m_current_request->lock;
+        m_last_decode->nr_outstanding++;
+        m_split_requests.push_back(transfer);
+        clear_pending(m_current_request);
+        m_current_request = (simple_bus_request *)0;
+      }
+      // otherwise the slave is still processing: no clearance of the
+      // current request
       break;
     }
     default:
@@ -425,84 +621,684 @@ void simple_bus::write(unsigned int unique_priority, int *data, unsigned int add
   }
 }
  
- simple_bus_slave_if *simple_bus::get_slave(unsigned int address)
+ unsigned int simple_bus::beat_words(unsigned int address
+                                     , unsigned int end_address
+                                     , simple_bus_decode_entry *slave)
+ {
+   // the narrower of bus and slave sets the beat; a beat does not cross
+   // a beat boundary and does not run past the end of the request
+   unsigned int width = (slave->data_words < m_data_words) ?
+     slave->data_words : m_data_words;
+   unsigned int words = width - (address / 4) % width;
+   unsigned int remaining = (end_address - address) / 4 + 1;
+   return (words < remaining) ? words : remaining;
+ }
+
+ simple_bus_status simple_bus::access_slave(simple_bus_request *request
+                                            , simple_bus_decode_entry *slave
+                                            , unsigned int words)
+ {
+   // a full single word takes the plain 32-bit slave interface
+   if ((words == 1) && (request->byte_enable == SIMPLE_BUS_WORD_ENABLE))
+     return request->do_write ?
+       slave->slave->write(request->data, request->address) :
+       slave->slave->read(request->data, request->address);
+   if (request->do_write)
+     return slave->slave->write_beat(request->data, request->address, words,
+                                     sb_beat_enable(words, request->byte_enable));
+   return slave->slave->read_beat(request->data, request->address, words);
+ }
+
+ void simple_bus::complete_beat(simple_bus_request *request, unsigned int words
+                                , simple_bus_decode_entry *slave)
+{
+  // Código existente para incrementar address y data
+  request->address+=4*words; //next beat (byte addressing)
+  request->data+=words;
+  
+  if (sb_metrics) {
+    // Agregar contadores para throughput (bytes habilitados del beat)
+    if (request->do_write)
+      m_metrics.bytes_transferred.add(sb_count_bits(sb_beat_enable(words, request->byte_enable)));
+    else
+      m_metrics.bytes_transferred.add(4*words);
+    m_metrics.transactions.add(1);
+  
+    // Contar separadamente lecturas y escrituras
+    if (request->do_write)
+      m_metrics.write_transactions.add(1);
+    else
+      m_metrics.read_transactions.add(1);
+  }
+  
+  if (request->address > request->end_address)
+  {
+    // burst-transfer (or single transfer) completed
+    if (request == m_prefetched_request)
+      m_prefetched_request = (simple_bus_request *)0;
+    set_status(request, SIMPLE_BUS_OK);
+    // a drained posted write was booked when the FIFO accepted it
+    if (sb_metrics && (request != &m_drain_request))
+      record_latency(request, slave);
+    trace_request(request);
+    request->transfer_done.notify();
+  }
+}
+
+ void simple_bus::record_latency(simple_bus_request *request
+                                 , simple_bus_decode_entry *slave)
+ {
+   // from posting the request to transfer_done: arbitration, the slave
+   // wait states and every beat of a burst
+   sc_time latency = sc_time_stamp() - request->post_time;
+   uint64_t latency_ps = sb_time_ps(latency);
+
+   // Acumular el tiempo según el tipo de transferencia
+   if (request->do_write) {
+     m_metrics.write_time.add(latency_ps);
+     m_metrics.write_latency.record(latency_ps);
+   } else {
+     m_metrics.read_time.add(latency_ps);
+     m_metrics.read_latency.record(latency_ps);
+   }
+   m_metrics.master_latency[request->priority].record(latency_ps);
+   m_metrics.slave_latency[slave->port_index].record(latency_ps);
+ }
+
+ void simple_bus::poll_split_requests()
  {
-   for (int i = 0; i < slave_port.size(); ++i)
+   // re-issue every parked transfer to its slave, except the ones that
+   // were parked in this very cycle (the slave has seen them already)
+   sc_time now = sc_time_stamp();
+   unsigned int i = 0;
+   while (i < m_split_requests.size())
      {
-       simple_bus_slave_if *slave = slave_port[i];
-       if ((slave->start_address() <= address) &&
-     (address <= slave->end_address()))
-   return slave;
+       simple_bus_split_transfer &transfer = m_split_requests[i];
+       simple_bus_request *request = transfer.request;
+       if (transfer.issued == now) {
+         ++i;
+         continue;
+       }
+
+       simple_bus_status slave_status =
+         access_slave(request, transfer.slave, transfer.words);
+       if (slave_status == SIMPLE_BUS_WAIT) {
+         request->wait_cycles++;
+         ++i;
+         continue;
+       }
+
+       // nothing may touch the lock of a parked locked burst
+       sc_assert(request->lock == transfer.lock);
+       transfer.slave->nr_outstanding--;
+       m_split_requests.erase(m_split_requests.begin() + i);
+       if (slave_status == SIMPLE_BUS_OK) {
+         complete_beat(request, transfer.words, transfer.slave);
+         // the next word of a burst competes in the next arbitration
+         if (request->status == SIMPLE_BUS_WAIT)
+           set_status(request, SIMPLE_BUS_WAIT);
+       } else {
+         set_status(request, SIMPLE_BUS_ERROR);
+         trace_request(request);
+         request->transfer_done.notify();
+       }
      }
-   return (simple_bus_slave_if *)0;		
  }
- 
- simple_bus_request * simple_bus::get_request(unsigned int priority)
+
+ void simple_bus::accept_posted_writes()
+ {
+   retire_posted_write();
+
+   // only requests that did not start yet: a write is accepted as a
+   // whole, a read is answered as a whole
+   for (unsigned int w = 0; w < m_pending_mask.size(); ++w)
+     {
+       unsigned long long bits = m_pending_mask[w];
+       while (bits)
+         {
+           simple_bus_request *request = m_requests[w*64 + sb_lowest_bit(bits)];
+           bits &= bits - 1;
+           if (postable(request))
+             {
+               if (m_posted_writes.size() >= m_posted_depth) {
+                 if (sb_metrics)
+                   m_metrics.write_stall_cycles.add(1);
+                 continue;
+               }
+               m_posted_writes.push_back(simple_bus_posted_write());
+               simple_bus_posted_write &posted = m_posted_writes.back();
+               posted.priority = request->priority;
+               posted.address = request->address;
+               posted.end_address = request->end_address;
+               posted.byte_enable = request->byte_enable;
+               posted.data.assign(request->data, request->data +
+                                  (request->end_address - request->address)/4 + 1);
+               if (sb_metrics)
+                 m_metrics.posted_writes.add(1);
+             }
+           else if (!request->do_write && (request->status == SIMPLE_BUS_REQUEST) &&
+                    (request->lock == SIMPLE_BUS_LOCK_NO) && forward_posted(request))
+             {
+               if (sb_metrics)
+                 m_metrics.forwarded_reads.add(1);
+             }
+           else
+             {
+               if (sb_metrics && (request != m_current_request) &&
+                   posted_overlap(request->address, request->end_address))
+                 m_metrics.read_stall_cycles.add(1);
+               continue;
+             }
+
+           // the master is done with the request
+           set_status(request, SIMPLE_BUS_OK);
+           if (sb_metrics)
+             record_latency(request, simple_bus_find_decode_entry(m_decode_table,
+                                                                  request->address));
+           trace_request(request);
+           request->transfer_done.notify();
+         }
+     }
+
+   if (sb_metrics)
+     m_metrics.posted_occupancy.record(m_posted_writes.size());
+ }
+
+ void simple_bus::retire_posted_write()
  {
-   simple_bus_request *request = (simple_bus_request *)0;
+   // the drain form is done with the head of the FIFO; a failed write
+   // was reported by handle_request
+   if (m_draining &&
+       ((m_drain_request.status == SIMPLE_BUS_OK) ||
+        (m_drain_request.status == SIMPLE_BUS_ERROR)))
+     {
+       m_posted_writes.pop_front();
+       m_draining = false;
+     }
+ }
+
+ void simple_bus::start_drain()
+ {
+   simple_bus_posted_write &head = m_posted_writes.front();
+   m_drain_request.priority = head.priority;
+   m_drain_request.do_write = true;
+   m_drain_request.address = head.address;
+   m_drain_request.start_address = head.address;
+   m_drain_request.end_address = head.end_address;
+   m_drain_request.data = &head.data[0];
+   m_drain_request.byte_enable = head.byte_enable;
+   m_drain_request.lock = SIMPLE_BUS_LOCK_NO;
+   m_drain_request.wait_cycles = 0;
+   m_draining = true;
+   set_status(&m_drain_request, SIMPLE_BUS_REQUEST);
+ }
+
+ bool simple_bus::lock_held() const
+ {
+   // a request form with its lock SET or GRANTED; clear_locks releases
+   // them once the bus has nothing to do
+   for (unsigned int i = 0; i < m_requests.size(); ++i)
+     if (m_requests[i]->lock != SIMPLE_BUS_LOCK_NO)
+       return true;
+   return false;
+ }
+
+ bool simple_bus::postable(simple_bus_request *request)
+ {
+   // a locked write or one the bus would reject takes the normal way
+   return request->do_write &&
+     (request->status == SIMPLE_BUS_REQUEST) &&
+     (request->lock == SIMPLE_BUS_LOCK_NO) &&
+     !(request->address % 4) &&
+     simple_bus_find_decode_entry(m_decode_table, request->address) &&
+     simple_bus_find_decode_entry(m_decode_table, request->end_address);
+ }
+
+ bool simple_bus::posted_hold(simple_bus_request *request)
+ {
+   // writes wait for room in the FIFO, requests that overlap it wait
+   // until it is drained
+   return postable(request) ||
+     posted_overlap(request->address, request->end_address);
+ }
+
+ bool simple_bus::posted_overlap(unsigned int address, unsigned int end_address)
+ {
+   for (std::deque<simple_bus_posted_write>::const_iterator it =
+          m_posted_writes.begin(); it != m_posted_writes.end(); ++it)
+     if ((address <= it->end_address) && (it->address <= end_address))
+       return true;
+   return false;
+ }
+
+ bool simple_bus::forward_posted(simple_bus_request *request)
+ {
+   // every word must come from a full-word write in the FIFO, the
+   // youngest one wins; check all words before copying any
+   unsigned int words = (request->end_address - request->address)/4 + 1;
+   for (unsigned int pass = 0; pass < 2; ++pass)
+     for (unsigned int i = 0; i < words; ++i)
+       {
+         unsigned int address = request->address + 4*i;
+         std::deque<simple_bus_posted_write>::const_reverse_iterator it =
+           m_posted_writes.rbegin();
+         while ((it != m_posted_writes.rend()) &&
+                ((address < it->address) || (address > it->end_address)))
+           ++it;
+         if ((it == m_posted_writes.rend()) ||
+             ((it->byte_enable & SIMPLE_BUS_WORD_ENABLE) != SIMPLE_BUS_WORD_ENABLE))
+           return false;
+         if (pass == 1)
+           request->data[i] = it->data[(address - it->address)/4];
+       }
+   return true;
+ }
+
+ void simple_bus::posted_read_word(int *data, unsigned int address)
+ {
+   // the enabled lanes of the writes still in the FIFO, oldest first
+   for (std::deque<simple_bus_posted_write>::const_iterator it =
+          m_posted_writes.begin(); it != m_posted_writes.end(); ++it)
+     if ((it->address <= address) && (address <= it->end_address))
+       sb_write_lanes(data, &it->data[(address - it->address)/4], 1, it->byte_enable);
+ }
+
+ void simple_bus::posted_write_word(const int *data, unsigned int address)
+ {
+   for (std::deque<simple_bus_posted_write>::iterator it =
+          m_posted_writes.begin(); it != m_posted_writes.end(); ++it)
+     if ((it->address <= address) && (address <= it->end_address))
+       it->data[(address - it->address)/4] = *data;
+ }
+
+ const simple_bus_metrics &simple_bus::metrics() const
+ {
+   return m_metrics;
+ }
+
+ //----------------------------------------------------------------------------
+ //-- checkpoints
+ //----------------------------------------------------------------------------
+
+ // a request form in a snapshot
+ struct simple_bus_request_state
+ {
+   uint32_t priority;
+   uint32_t do_write;
+   uint32_t address;
+   uint32_t start_address;
+   uint32_t end_address;
+   uint32_t byte_enable;
+   uint32_t lock;
+   uint32_t status;
+   uint32_t wait_cycles;
+   uint32_t reserved;
+   uint64_t post_time_ps;
+ };
+
+ bool simple_bus::snapshot_ready() const
+ {
+   if (m_current_request || m_prefetched_request || !m_split_requests.empty() ||
+       m_draining || !m_posted_writes.empty())
+     return false;
+   for (unsigned int w = 0; w < m_pending_mask.size(); ++w)
+     if (m_pending_mask[w])
+       return false;
+   return true;
+ }
+
+ bool simple_bus::save_state(FILE *file) const
+ {
+   if (!snapshot_ready())
+     return false;
+   uint32_t nr_requests = m_requests.size();
+   if (fwrite(&nr_requests, sizeof(nr_requests), 1, file) != 1)
+     return false;
+   for (unsigned int i = 0; i < m_requests.size(); ++i)
+     {
+       const simple_bus_request *request = m_requests[i];
+       simple_bus_request_state state;
+       state.priority = request->priority;
+       state.do_write = request->do_write ? 1 : 0;
+       state.address = request->address;
+       state.start_address = request->start_address;
+       state.end_address = request->end_address;
+       state.byte_enable = request->byte_enable;
+       state.lock = request->lock;
+       state.status = request->status;
+       state.wait_cycles = request->wait_cycles;
+       state.reserved = 0;
+       state.post_time_ps = sb_time_ps(request->post_time);
+       if (fwrite(&state, sizeof(state), 1, file) != 1)
+         return false;
+     }
+   return true;
+ }
+
+ bool simple_bus::restore_state(FILE *file)
+ {
+   uint32_t nr_requests;
+   if (!snapshot_ready() ||
+       (fread(&nr_requests, sizeof(nr_requests), 1, file) != 1))
+     return false;
+
+   // forms missing from the snapshot start out unlocked
    for (unsigned int i = 0; i < m_requests.size(); ++i)
      {
-       request = m_requests[i];
-       if ((request) &&
-     (request->priority == priority))
-   return request;
+       m_requests[i]->lock = SIMPLE_BUS_LOCK_NO;
+       m_requests[i]->status = SIMPLE_BUS_OK;
+     }
+   for (unsigned int i = 0; i < nr_requests; ++i)
+     {
+       simple_bus_request_state state;
+       if ((fread(&state, sizeof(state), 1, file) != 1) ||
+           ((state.status != SIMPLE_BUS_OK) && (state.status != SIMPLE_BUS_ERROR)) ||
+           (state.lock > SIMPLE_BUS_LOCK_GRANTED))
+         return false;
+       simple_bus_request *request = get_request(state.priority);
+       request->do_write = (state.do_write != 0);
+       request->address = state.address;
+       request->start_address = state.start_address;
+       request->end_address = state.end_address;
+       request->byte_enable = state.byte_enable;
+       request->lock = (simple_bus_lock_status)state.lock;
+       request->status = (simple_bus_status)state.status;
+       request->wait_cycles = state.wait_cycles;
+       request->post_time = sc_time((double)state.post_time_ps, SC_PS);
+     }
+   return true;
+ }
+
+ bool simple_bus::trace_transactions(const char *file_name)
+ {
+   if (!m_trace)
+     m_trace = new simple_bus_trace_recorder;
+   if (m_trace->open(file_name))
+     return true;
+   sb_fprintf(stdout, "%s : cannot open trace file %s\n", name(), file_name);
+   return false;
+ }
+
+ void simple_bus::trace_request(simple_bus_request *request)
+ {
+   if (!m_trace || !m_trace->is_open() || (request == &m_drain_request))
+     return;
+   simple_bus_trace_record record;
+   record.time_ps = sb_time_ps(sc_time_stamp());
+   record.address = request->start_address;
+   record.length = (request->end_address - request->start_address) / 4 + 1;
+   record.wait_cycles = request->wait_cycles;
+   record.priority = (uint16_t)request->priority;
+   record.do_write = request->do_write ? 1 : 0;
+   record.status = (uint8_t)request->status;
+   m_trace->record(record);
+ }
+
+ void simple_bus::set_split_transactions(bool enable)
+ {
+   m_split_transactions = enable;
+ }
+
+ void simple_bus::set_outstanding_depth(simple_bus_slave_if *slave
+                                        , unsigned int depth)
+ {
+   sc_assert(depth > 0);
+   m_outstanding_depth[slave] = depth;
+   for (unsigned int i = 0; i < m_decode_table.size(); ++i)
+     if (m_decode_table[i].slave == slave)
+       m_decode_table[i].max_outstanding = depth;
+ }
+
+ void simple_bus::set_posted_writes(unsigned int depth)
+ {
+   sc_assert(depth || m_posted_writes.empty());
+   m_posted_depth = depth;
+   if (depth)
+     m_dmi_listeners.invalidate(0, ~0u);
+ }
+
+ simple_bus_slave_if *simple_bus::get_slave(unsigned int address)
+ {
+   // bursts usually stay inside the slave of the previous access
+   if (m_last_decode &&
+       (m_last_decode->start_address <= address) &&
+       (address <= m_last_decode->end_address))
+     return m_last_decode->slave;
+
+   simple_bus_decode_entry *entry = simple_bus_find_decode_entry(m_decode_table, address);
+   if (!entry)
+     return (simple_bus_slave_if *)0;
+   m_last_decode = entry;
+   return entry->slave;
+ }
+
+ void simple_bus::build_decode_table()
+ {
+   // the address map is static after elaboration: query every slave
+   // once and keep the ranges sorted on start address, so get_slave
+   // needs neither a linear scan nor virtual calls
+   simple_bus_build_decode_table(m_decode_table, slave_port);
+   for (unsigned int i = 0; i < m_decode_table.size(); ++i)
+     {
+       std::map<simple_bus_slave_if *, unsigned int>::const_iterator depth =
+         m_outstanding_depth.find(m_decode_table[i].slave);
+       if (depth != m_outstanding_depth.end())
+         m_decode_table[i].max_outstanding = depth->second;
      }
-   request = new simple_bus_request;
+   m_last_decode = (simple_bus_decode_entry *)0;
+ }
+ 
+ simple_bus_request * simple_bus::get_request(unsigned int priority)
+ {
+   // the request forms are indexed on priority: a master gets its slot
+   // on its first call, every later call is a direct lookup
+   simple_bus_request *found = m_request_index.find(priority);
+   if (found)
+     return found;
+
+   simple_bus_request *request = new simple_bus_request;
    request->priority = priority;
+   request->slot = m_requests.size();
    m_requests.push_back(request);
+   if (m_requests.size() > m_pending_mask.size()*64)
+     m_pending_mask.push_back(0ULL);
+   m_arbitration_queue.reserve(m_requests.size());
+   m_request_index.insert(request);
    return request;		
  }
  
  simple_bus_request * simple_bus::get_next_request()
  {
    // the slave is done with its action, m_current_request is
-   // empty, so go over the bag of request-forms and compose
-   // a set of likely requests. Pass it to the arbiter for the
-   // final selection
-   simple_bus_request_vec Q;
-   for (unsigned int i = 0; i < m_requests.size(); ++i)
+   // empty, so compose the set of likely requests out of the
+   // pending-slot mask (in slot order) and pass it to the arbiter
+   // for the final selection. The queue is a member, so its storage
+   // is reused from cycle to cycle.
+   // posted data never goes between the bursts of a master that holds
+   // a lock: the drain waits until the locks are released
+   bool locked = (m_drain_pending || !m_posted_writes.empty()) && lock_held();
+   if (m_drain_pending && !locked && !split_hold(m_drain_request.address))
+     return &m_drain_request; // the next beat of a drained burst
+   m_arbitration_queue.clear();
+   bool held = false;
+   for (unsigned int w = 0; w < m_pending_mask.size(); ++w)
      {
-       simple_bus_request *request = m_requests[i];
-       if ((request->status == SIMPLE_BUS_REQUEST) ||
-     (request->status == SIMPLE_BUS_WAIT))
-   {
-     if (m_verbose) 
-       sb_fprintf(stdout, "%s %s : request (%d) [%s]\n",
-            sc_time_stamp().to_string().c_str(), name(), 
-            request->priority, simple_bus_status_str[request->status]);
-     Q.push_back(request);
-   }
+       unsigned long long bits = m_pending_mask[w];
+       while (bits)
+         {
+           simple_bus_request *request = m_requests[w*64 + sb_lowest_bit(bits)];
+           bits &= bits - 1;
+           if (m_posted_depth && posted_hold(request))
+             {
+               held = true;
+               continue;
+             }
+           // split mode: a request for a slave that holds its maximum
+           // number of parked transfers would only waste the bus cycle;
+           // a second access to a parked address would be mistaken for
+           // the first one by the slave
+           if (split_hold(request->address))
+             continue;
+           if (sb_logging && m_verbose) 
+             sb_fprintf(stdout, "%s %s : request (%d) [%s]\n",
+                        sc_time_stamp().to_string().c_str(), name(), 
+                        request->priority, simple_bus_status_str[request->status]);
+           m_arbitration_queue.push_back(request);
+         }
+     }
+   // the FIFO drains while nobody else wants the bus, and before the
+   // requests that wait for it
+   if (!m_posted_writes.empty() && !m_draining && !locked &&
+       (held || m_arbitration_queue.empty()) &&
+       !split_hold(m_posted_writes.front().address))
+     {
+       start_drain();
+       return &m_drain_request;
+     }
+   if (m_arbitration_queue.size() > 0)
+     {
+       if (sb_metrics) {
+         m_metrics.arbitrations.add(1);
+         m_metrics.arbitration_rejections.add(m_arbitration_queue.size() - 1);
+       }
+       return arbiter_port->arbitrate(m_arbitration_queue);
      }
-   if (Q.size() > 0)
-     return arbiter_port->arbitrate(Q);
    return (simple_bus_request *)0;
  }
+
+ bool simple_bus::split_hold(unsigned int address)
+ {
+   if (!m_split_transactions)
+     return false;
+   simple_bus_decode_entry *entry =
+     simple_bus_find_decode_entry(m_decode_table, address);
+   if (entry && (entry->nr_outstanding >= entry->max_outstanding))
+     return true;
+   // slaves tell parked transfers apart by their address only
+   for (unsigned int i = 0; i < m_split_requests.size(); ++i)
+     if (m_split_requests[i].request->address == address)
+       return true;
+   return false;
+ }
+
+ void simple_bus::set_status(simple_bus_request *request, simple_bus_status status)
+ {
+   if (request == &m_drain_request)
+     {
+       // the drain form has no slot, get_next_request picks it itself
+       m_drain_pending = (status == SIMPLE_BUS_REQUEST) || (status == SIMPLE_BUS_WAIT);
+       request->status = status;
+       return;
+     }
+   // keep the pending-slot mask in step with the request status
+   unsigned long long bit = 1ULL << (request->slot % 64);
+   if ((status == SIMPLE_BUS_REQUEST) || (status == SIMPLE_BUS_WAIT))
+     m_pending_mask[request->slot / 64] |= bit;
+   else
+     m_pending_mask[request->slot / 64] &= ~bit;
+   request->status = status;
+   arbiter_port->update(request, (m_pending_mask[request->slot / 64] & bit) != 0);
+ }
  
+ void simple_bus::clear_pending(simple_bus_request *request)
+ {
+   // the request keeps its status, but is no candidate for arbitration
+   if (request == &m_drain_request)
+     {
+       m_drain_pending = false;
+       return;
+     }
+   m_pending_mask[request->slot / 64] &= ~(1ULL << (request->slot % 64));
+   arbiter_port->update(request, false);
+ }
+
+ bool simple_bus::is_idle()
+ {
+   if (!m_split_requests.empty() || !m_posted_writes.empty())
+     return false;
+   for (unsigned int w = 0; w < m_pending_mask.size(); ++w)
+     if (m_pending_mask[w])
+       return false;
+   for (unsigned int i = 0; i < m_requests.size(); ++i)
+     if (m_requests[i]->lock != SIMPLE_BUS_LOCK_NO)
+       return false;
+   return true;
+ }
+
  void simple_bus::clear_locks()
  {
    for (unsigned int i = 0; i < m_requests.size(); ++i)
-     if (m_requests[i]->lock == SIMPLE_BUS_LOCK_GRANTED)
-       m_requests[i]->lock = SIMPLE_BUS_LOCK_SET;
-     else
-       m_requests[i]->lock = SIMPLE_BUS_LOCK_NO;
+     {
+       // a parked transfer keeps its lock, as the current request does
+       // while its slave answers SIMPLE_BUS_WAIT
+       simple_bus_request *request = m_requests[i];
+       if (is_parked(request))
+         continue;
+       simple_bus_lock_status lock = request->lock;
+       if (lock == SIMPLE_BUS_LOCK_GRANTED)
+         request->lock = SIMPLE_BUS_LOCK_SET;
+       else
+         request->lock = SIMPLE_BUS_LOCK_NO;
+       if (request->lock != lock)
+         arbiter_port->update(request, (m_pending_mask[request->slot / 64] >>
+                                        (request->slot % 64)) & 1ULL);
+     }
+ }
+
+ bool simple_bus::is_parked(simple_bus_request *request) const
+ {
+   for (unsigned int i = 0; i < m_split_requests.size(); ++i)
+     if (m_split_requests[i].request == request)
+       return true;
+   return false;
  }
  
+ // una línea del reporte de latencias: percentiles en ns
+ static void report_latency(const char *label, const simple_bus_histogram &histogram)
+ {
+   if (histogram.count() == 0) {
+     sb_fprintf(stdout, "%s: sin peticiones\n", label);
+     return;
+   }
+   sb_fprintf(stdout, "%s: n=%llu p50=%.3f p90=%.3f p99=%.3f max=%.3f\n", label,
+              (unsigned long long)histogram.count(),
+              histogram.percentile(50) / 1000.0, histogram.percentile(90) / 1000.0,
+              histogram.percentile(99) / 1000.0, histogram.max() / 1000.0);
+ }
+
  // Función para reportar la utilización del bus
  void simple_bus::report_bus_utilization()
  {
-   if (total_simulation_time > SC_ZERO_TIME) {
+   if (!sb_metrics) {
+     sb_fprintf(stdout, "Métricas del bus desactivadas en esta compilación (SIMPLE_BUS_NO_METRICS)\n");
+     return;
+   }
+
+   // valores actuales de las métricas de este bus
+   double simulation_time_sec = m_metrics.simulation_time.get() * 1e-12;
+   double active_time_sec = m_metrics.active_time.get() * 1e-12;
+   unsigned long total_bytes_transferred = m_metrics.bytes_transferred.get();
+   unsigned int total_transactions = m_metrics.transactions.get();
+   unsigned int read_transactions = m_metrics.read_transactions.get();
+   unsigned int write_transactions = m_metrics.write_transactions.get();
+   unsigned int read_transfers_started = m_metrics.read_transfers_started.get();
+   unsigned int write_transfers_started = m_metrics.write_transfers_started.get();
+   double total_read_time = m_metrics.read_time.get() * 1e-12;
+   double total_write_time = m_metrics.write_time.get() * 1e-12;
+
+   if (simulation_time_sec > 0.0) {
      // Reporte de utilización del bus
-     double utilization = (bus_active_time.to_seconds() / total_simulation_time.to_seconds()) * 100;
+     double utilization = (active_time_sec / simulation_time_sec) * 100;
      sb_fprintf(stdout, "====================================\n");
      sb_fprintf(stdout, " Nivel de utilización del bus: %.2f%% \n", utilization);
      sb_fprintf(stdout, "====================================\n");
      
      // Reporte de throughput
-     double simulation_time_sec = total_simulation_time.to_seconds();
      double bytes_per_second = total_bytes_transferred / simulation_time_sec;
      double transactions_per_second = total_transactions / simulation_time_sec;
      
      sb_fprintf(stdout, "\n--- Métricas de Throughput ---\n");
+     sb_fprintf(stdout, "Ancho del bus de datos: %u bits\n", m_data_words * 32);
      sb_fprintf(stdout, "Bytes transferidos: %lu bytes\n", total_bytes_transferred);
      sb_fprintf(stdout, "Transacciones completadas: %u (Lecturas: %u, Escrituras: %u)\n", 
                 total_transactions, read_transactions, write_transactions);
@@ -514,10 +1310,10 @@ void simple_bus::write(unsigned int unique_priority, int *data, unsigned int add
      // Reporte de duración de transferencias
      sb_fprintf(stdout, "\n--- Métricas de Duración de Transferencias ---\n");
      
-     // Calcular duración promedio de lecturas
+     // Calcular duración promedio de lecturas (por petición completada)
      double avg_read_duration = 0.0;
-     if (read_transactions > 0) {
-       avg_read_duration = total_read_time.to_seconds() / read_transactions;
+     if (m_metrics.read_latency.count() > 0) {
+       avg_read_duration = total_read_time / m_metrics.read_latency.count();
        sb_fprintf(stdout, "Duración promedio de lectura: %.12f segundos\n", avg_read_duration);
      } else {
        sb_fprintf(stdout, "No se realizaron transferencias de lectura\n");
@@ -525,8 +1321,8 @@ void simple_bus::write(unsigned int unique_priority, int *data, unsigned int add
      
      // Calcular duración promedio de escrituras
      double avg_write_duration = 0.0;
-     if (write_transactions > 0) {
-       avg_write_duration = total_write_time.to_seconds() / write_transactions;
+     if (m_metrics.write_latency.count() > 0) {
+       avg_write_duration = total_write_time / m_metrics.write_latency.count();
        sb_fprintf(stdout, "Duración promedio de escritura: %.12f segundos\n", avg_write_duration);
      } else {
        sb_fprintf(stdout, "No se realizaron transferencias de escritura\n");
@@ -552,6 +1348,38 @@ void simple_bus::write(unsigned int unique_priority, int *data, unsigned int add
      } else {
        sb_fprintf(stdout, "No se puede calcular la relación de tiempo lectura/escritura (datos insuficientes)\n");
      }
+
+     // Distribución de latencias, de la petición a transfer_done
+     sb_fprintf(stdout, "\n--- Latencia por petición (ns) ---\n");
+     report_latency("Lecturas", m_metrics.read_latency);
+     report_latency("Escrituras", m_metrics.write_latency);
+     char label[64];
+     for (std::map<unsigned int, simple_bus_histogram>::const_iterator it =
+            m_metrics.master_latency.begin(); it != m_metrics.master_latency.end(); ++it) {
+       snprintf(label, sizeof(label), "Maestro %u", it->first);
+       report_latency(label, it->second);
+     }
+     for (unsigned int i = 0; i < m_decode_table.size(); ++i) {
+       const simple_bus_decode_entry &entry = m_decode_table[i];
+       snprintf(label, sizeof(label), "Esclavo %u (%0X..%0X)", entry.port_index,
+                entry.start_address, entry.end_address);
+       report_latency(label, m_metrics.slave_latency[entry.port_index]);
+     }
+
+     if (m_posted_depth) {
+       const simple_bus_histogram &occupancy = m_metrics.posted_occupancy;
+       sb_fprintf(stdout, "\n--- Escrituras diferidas (FIFO de %u) ---\n", m_posted_depth);
+       sb_fprintf(stdout, "Escrituras aceptadas: %llu, lecturas servidas desde la FIFO: %llu\n",
+                  (unsigned long long)m_metrics.posted_writes.get(),
+                  (unsigned long long)m_metrics.forwarded_reads.get());
+       sb_fprintf(stdout, "Ciclos de espera: escrituras (FIFO llena) %llu, lecturas (conflicto RAW) %llu\n",
+                  (unsigned long long)m_metrics.write_stall_cycles.get(),
+                  (unsigned long long)m_metrics.read_stall_cycles.get());
+       if (occupancy.count() > 0)
+         sb_fprintf(stdout, "Ocupación de la FIFO: media %.2f, p90 %llu, máx %llu\n",
+                    occupancy.mean(), (unsigned long long)occupancy.percentile(90),
+                    (unsigned long long)occupancy.max());
+     }
      
      sb_fprintf(stdout, "====================================\n");
    } else {
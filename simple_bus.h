@@ -21,11 +21,19 @@
  
   simple_bus.h : The bus.
 
+		 The data path is data_width bytes wide (4, 8, 16 or 32):
+		 one beat moves up to data_width/4 words, limited by the
+		 data width of the slave.
+
 		 The bus is derived from the following interfaces, and
 	         contains the implementation of these: 
 		 - blocking : burst_read/burst_write
-		 - non-blocking : read/write/get_status
+		 - non-blocking : read/write/write_bytes/get_status
 		 - direct : direct_read/direct_write
+		 - loosely-timed : b_transport
+
+		 Optionally the bus posts writes: a FIFO accepts them and
+		 drains them to the slaves in the background.
  
   Original Author: Ric Hilderink, Synopsys, Inc., 2001-10-11
  
@@ -45,38 +53,51 @@
  #define __simple_bus_h
  
  #include <systemc.h>
+ #include <deque>
+ #include <map>
+ #include <vector>
  
  #include "simple_bus_types.h"
  #include "simple_bus_request.h"
  #include "simple_bus_direct_if.h"
  #include "simple_bus_non_blocking_if.h"
  #include "simple_bus_blocking_if.h"
+ #include "simple_bus_lt_if.h"
  #include "simple_bus_arbiter_if.h"
  #include "simple_bus_slave_if.h"
- 
- // Variables para medir el uso del bus
- extern sc_time bus_active_time;
- extern sc_time total_simulation_time;
- extern sc_time last_time_stamp;
+ #include "simple_bus_decoder.h"
+ #include "simple_bus_trace.h"
+ #include "simple_bus_metrics.h"
+ #include "simple_bus_snapshot.h"
 
- // Variables troghuput
-extern unsigned long total_bytes_transferred;
-extern unsigned int total_transactions;
-extern unsigned int read_transactions;
-extern unsigned int write_transactions;
+ // split mode: a transfer parked at a slave that answered SIMPLE_BUS_WAIT
+ struct simple_bus_split_transfer
+ {
+   simple_bus_request *request;
+   simple_bus_decode_entry *slave;
+   unsigned int words; // beat size
+   sc_time issued;
+   simple_bus_lock_status lock; // when parked
+ };
 
-// variables mediciones in out
-extern sc_time total_read_time;
-extern sc_time total_write_time;
-extern sc_time current_transfer_start_time;
+ // posted writes: a write request accepted into the FIFO, with a copy
+ // of its data; the master is done with it
+ struct simple_bus_posted_write
+ {
+   unsigned int priority;
+   unsigned int address;
+   unsigned int end_address;
+   unsigned int byte_enable; // strobes applied to every word
+   std::vector<int> data;
+ };
 
-extern unsigned int read_transfers_started;
-extern unsigned int write_transfers_started;
- 
  class simple_bus
    : public simple_bus_direct_if
    , public simple_bus_non_blocking_if
    , public simple_bus_blocking_if
+   , public simple_bus_lt_if
+   , public simple_bus_dmi_invalidate_if
+   , public simple_bus_snapshot_if
    , public sc_module
  {
  public:
@@ -88,19 +109,35 @@ extern unsigned int write_transfers_started;
  
 // constructor
 simple_bus(sc_module_name name_
-  , bool verbose = false)
+  , bool verbose = false
+  , unsigned int data_width = 4)
 : sc_module(name_)
 , m_verbose(verbose)
+, m_data_words(data_width / 4)
 , m_current_request(0)
+, m_idle(false)
+, m_last_decode(0)
+, m_prefetched_request(0)
+, m_split_transactions(false)
+, m_posted_depth(0)
+, m_draining(false)
+, m_drain_pending(false)
+, m_trace(0)
+, m_metrics(name())
+, m_last_time_stamp(SC_ZERO_TIME)
 {
 // process declaration
 SC_METHOD(main_action);
 dont_initialize();
 sensitive << clock.neg();
 
-// Inicializar el tiempo de la última marca
-last_time_stamp = SC_ZERO_TIME;
+// the strobes of a beat must fit in one unsigned int
+sc_assert((data_width >= 4) && (data_width <= 32) &&
+	  !(data_width & (data_width - 1)));
 }
+
+// destructor
+~simple_bus();
  
    // process
    void main_action();
@@ -112,6 +149,12 @@ last_time_stamp = SC_ZERO_TIME;
    // direct BUS interface
    bool direct_read(int *data, unsigned int address);
    bool direct_write(int *data, unsigned int address);
+   bool get_direct_mem_ptr(unsigned int address, simple_bus_dmi &dmi);
+   void register_dmi_listener(simple_bus_dmi_invalidate_if *listener);
+
+   // DMI invalidation coming from a slave: passed on to the masters
+   void invalidate_direct_mem_ptr(unsigned int start_address
+                                  , unsigned int end_address);
  
    // non-blocking BUS interface
    void read(unsigned int unique_priority
@@ -122,6 +165,11 @@ last_time_stamp = SC_ZERO_TIME;
         , int *data
         , unsigned int address
         , bool lock = false);
+   void write_bytes(unsigned int unique_priority
+        , int *data
+        , unsigned int address
+        , unsigned int byte_enable
+        , bool lock = false);
    simple_bus_status get_status(unsigned int unique_priority);
  
    // blocking BUS interface
@@ -135,22 +183,130 @@ last_time_stamp = SC_ZERO_TIME;
          , unsigned int start_address
          , unsigned int length = 1
          , bool lock = false);
+
+   // loosely-timed BUS interface: bypasses arbitration, the delay is
+   // one clock period per beat plus the wait states of the slave
+   simple_bus_status b_transport(bool do_write
+              , int *data
+              , unsigned int start_address
+              , unsigned int length
+              , sc_time &delay);
  
  public:
    // Función para reportar la utilización del bus (ahora pública)
    void report_bus_utilization();
 
+   // métricas de este bus, también en simple_bus_metrics_registry
+   const simple_bus_metrics &metrics() const;
+
+   // split-transaction mode: a slave answering SIMPLE_BUS_WAIT gets the
+   // transfer parked and the bus serves other masters in the meantime.
+   // A slave accepts up to depth parked transfers (default 1); depth > 1
+   // needs a slave that keeps interleaved accesses apart by address, as
+   // the bus never parks two transfers to the same address.
+   void set_split_transactions(bool enable);
+   void set_outstanding_depth(simple_bus_slave_if *slave, unsigned int depth);
+
+   // posted writes: up to depth unlocked write requests are accepted
+   // into a FIFO and completed at once; the bus drains the FIFO while no
+   // master competes for it, or first when a request waits for it. A
+   // read the FIFO holds completely is answered from it, one that
+   // overlaps it waits until the writes are drained. 0 (default): off.
+   // Direct memory access is refused while posted writes are on.
+   void set_posted_writes(unsigned int depth);
+
+   // binary transaction trace: one record per finished request, see
+   // simple_bus_trace_format.h; simple_bus_trace_decode converts it
+   bool trace_transactions(const char *file_name);
+
+   // checkpoints: the request forms with their lock states; only
+   // between transfers (no request pending, parked or current)
+   bool snapshot_ready() const;
+   bool save_state(FILE *file) const;
+   bool restore_state(FILE *file);
+
  private:
    void handle_request();
    simple_bus_slave_if * get_slave(unsigned int address);
    simple_bus_request * get_request(unsigned int priority);
    simple_bus_request * get_next_request();
+   bool split_hold(unsigned int address);
+   void set_status(simple_bus_request *request, simple_bus_status status);
+   void clear_pending(simple_bus_request *request);
+   unsigned int beat_words(unsigned int address
+                           , unsigned int end_address
+                           , simple_bus_decode_entry *slave);
+   simple_bus_status access_slave(simple_bus_request *request
+                                  , simple_bus_decode_entry *slave
+                                  , unsigned int words);
+   void complete_beat(simple_bus_request *request, unsigned int words
+                      , simple_bus_decode_entry *slave);
+   void record_latency(simple_bus_request *request
+                       , simple_bus_decode_entry *slave);
+   void poll_split_requests();
+   void accept_posted_writes();
+   void retire_posted_write();
+   void start_drain();
+   bool lock_held() const;
+   bool postable(simple_bus_request *request);
+   bool posted_hold(simple_bus_request *request);
+   bool posted_overlap(unsigned int address, unsigned int end_address);
+   bool forward_posted(simple_bus_request *request);
+   void posted_read_word(int *data, unsigned int address);
+   void posted_write_word(const int *data, unsigned int address);
+   void trace_request(simple_bus_request *request);
    void clear_locks();
+   bool is_parked(simple_bus_request *request) const;
+   bool is_idle();
+   void build_decode_table();
  
  private:
    bool m_verbose;
-   simple_bus_request_vec m_requests;
+   unsigned int m_data_words;             // words per beat
+   sc_time m_clock_period;                // for loosely-timed transfers
+   simple_bus_request_vec m_requests;     // request forms, in slot order
+   simple_bus_request_index m_request_index; // priority -> request form
    simple_bus_request *m_current_request;
+
+   // slots in SIMPLE_BUS_REQUEST/SIMPLE_BUS_WAIT state, 64 per word,
+   // and the candidate list handed to the arbiter
+   std::vector<unsigned long long> m_pending_mask;
+   simple_bus_request_vec m_arbitration_queue;
+
+   // idle mode: main_action waits for m_request_posted instead of
+   // running on every falling clock edge
+   bool m_idle;
+   sc_event m_request_posted;
+
+   // address decoding: slaves sorted on start address, plus the
+   // entry of the last hit (bursts mostly stay within one slave)
+   simple_bus_decode_table m_decode_table;
+   simple_bus_decode_entry *m_last_decode;
+
+   // burst read whose remaining words were already fetched with one
+   // native slave->burst_read call; its beats only advance the request
+   simple_bus_request *m_prefetched_request;
+
+   simple_bus_dmi_listeners m_dmi_listeners;
+
+   // split-transaction mode
+   bool m_split_transactions;
+   std::map<simple_bus_slave_if *, unsigned int> m_outstanding_depth;
+   std::vector<simple_bus_split_transfer> m_split_requests;
+
+   // posted writes: the FIFO, and the request form of the bus itself
+   // that writes its head to the slave
+   unsigned int m_posted_depth;
+   std::deque<simple_bus_posted_write> m_posted_writes;
+   simple_bus_request m_drain_request;
+   bool m_draining;      // m_drain_request holds the head of the FIFO
+   bool m_drain_pending; // ... and competes for the bus
+
+   simple_bus_trace_recorder *m_trace;
+
+   // Métricas del bus (por instancia)
+   simple_bus_metrics m_metrics;
+   sc_time m_last_time_stamp; // para medir el tiempo activo
  };
  // end class simple_bus
  
@@ -37,17 +37,22 @@
 
  #include "simple_bus_arbiter.h"
 
+ const char *simple_bus_arbiter_policy_str[4] = { "priority"
+                                                  , "round-robin"
+                                                  , "weighted"
+                                                  , "tdma" };
+
  simple_bus_request *
  simple_bus_arbiter::arbitrate(const simple_bus_request_vec &requests)
  {
    // Registrar tiempo de inicio del arbitraje
-   sc_time arbitration_start_time = sc_time_stamp();
+   sc_time arbitration_start_time = sb_metrics ? sc_time_stamp() : SC_ZERO_TIME;
    
    unsigned int i;
    // at least one request is here
    simple_bus_request *best_request = requests[0]; 
  
-   if (m_verbose) 
+   if (sb_logging && m_verbose) 
      { // shows the list of pending requests
        sb_fprintf(stdout, "%s %s :", sc_time_stamp().to_string().c_str(), name());
        for (i = 0; i < requests.size(); ++i)
@@ -73,15 +78,9 @@
      (request->lock == SIMPLE_BUS_LOCK_SET))
    {
      // cannot break-in a locked burst
-     if (m_verbose)
+     if (sb_logging && m_verbose)
              sb_fprintf(stdout, " -> R[%d] (rule 1)\n", request->priority);
-           
-           // Actualizar métricas de arbitraje
-           arbitration_decisions++;
-           master_grants[request->priority]++;
-           total_request_rejections += requests.size() - 1;
-           total_arbitration_wait_time += sc_time_stamp() - arbitration_start_time;
-           
+           grant(request, requests.size(), arbitration_start_time);
      return request;
    }
      }
@@ -91,44 +90,157 @@
    for (i = 0; i < requests.size(); ++i)
      if (requests[i]->lock == SIMPLE_BUS_LOCK_GRANTED)
        {
-   if (m_verbose)
+   if (sb_logging && m_verbose)
      sb_fprintf(stdout, " -> R[%d] (rule 2)\n", requests[i]->priority);
-           
-         // Actualizar métricas de arbitraje
-         arbitration_decisions++;
-         master_grants[requests[i]->priority]++;
-         total_request_rejections += requests.size() - 1;
-         total_arbitration_wait_time += sc_time_stamp() - arbitration_start_time;
-         
+         grant(requests[i], requests.size(), arbitration_start_time);
    return requests[i];
        }
  
-   // third priority: priority
-   for (i = 1; i < requests.size(); ++i)
-     {
-       sc_assert(requests[i]->priority != best_request->priority);
-       if (requests[i]->priority < best_request->priority)
-   best_request = requests[i];
-     }
+   // third priority: the arbitration policy (fixed priority by default)
+   best_request = select_by_policy(requests);
  
    if (best_request->lock != SIMPLE_BUS_LOCK_NO)
      best_request->lock = SIMPLE_BUS_LOCK_GRANTED;
    
-   if (m_verbose) 
+   if (sb_logging && m_verbose) 
      sb_fprintf(stdout, " -> R[%d] (rule 3)\n", best_request->priority);
  
+   grant(best_request, requests.size(), arbitration_start_time);
+   return best_request;
+ }
+
+ void simple_bus_arbiter::grant(const simple_bus_request *request
+                                , unsigned int nr_requests
+                                , const sc_time &arbitration_start_time)
+ {
+   if (!sb_metrics)
+     return;
+
    // Actualizar métricas de arbitraje
    arbitration_decisions++;
-   master_grants[best_request->priority]++;
-   total_request_rejections += requests.size() - 1;
+   master_grants[request->priority]++;
+   total_request_rejections += nr_requests - 1;
    total_arbitration_wait_time += sc_time_stamp() - arbitration_start_time;
-   
+ }
+ 
+ simple_bus_request *
+ simple_bus_arbiter::select_by_policy(const simple_bus_request_vec &requests)
+ {
+   simple_bus_request *best_request;
+   switch (m_policy)
+     {
+     case SIMPLE_BUS_ARB_ROUND_ROBIN:
+       best_request = select_round_robin(requests);
+       break;
+     case SIMPLE_BUS_ARB_WEIGHTED:
+       best_request = select_weighted(requests);
+       break;
+     case SIMPLE_BUS_ARB_TDMA:
+       best_request = select_tdma(requests);
+       break;
+     default:
+       best_request = select_by_priority(requests);
+       break;
+     }
+   m_last_granted = best_request->priority;
+   m_has_granted = true;
+   return best_request;
+ }
+ 
+ simple_bus_request *
+ simple_bus_arbiter::select_by_priority(const simple_bus_request_vec &requests)
+ {
+   simple_bus_request *best_request = requests[0]; 
+   for (unsigned int i = 1; i < requests.size(); ++i)
+     {
+       sc_assert(requests[i]->priority != best_request->priority);
+       if (requests[i]->priority < best_request->priority)
+   best_request = requests[i];
+     }
    return best_request;
  }
  
+ simple_bus_request *
+ simple_bus_arbiter::select_round_robin(const simple_bus_request_vec &requests)
+ {
+   // the first priority after the last granted one, cyclically
+   simple_bus_request *next = (simple_bus_request *)0;
+   simple_bus_request *first = requests[0];
+   for (unsigned int i = 0; i < requests.size(); ++i)
+     {
+       simple_bus_request *request = requests[i];
+       if (request->priority < first->priority)
+         first = request;
+       if ((!m_has_granted || (request->priority > m_last_granted)) &&
+           (!next || (request->priority < next->priority)))
+         next = request;
+     }
+   return next ? next : first;
+ }
+ 
+ simple_bus_request *
+ simple_bus_arbiter::select_weighted(const simple_bus_request_vec &requests)
+ {
+   // deficit round-robin with one word as the unit of work: the last
+   // granted master keeps the bus while it has credit left, otherwise
+   // the next master in round-robin order gets its weight as credit.
+   // Masters without a request lose their credit.
+   simple_bus_request *current = (simple_bus_request *)0;
+   for (unsigned int i = 0; i < requests.size(); ++i)
+     if (m_has_granted && (requests[i]->priority == m_last_granted))
+       current = requests[i];
+   if (m_has_granted && !current)
+     m_deficits[m_last_granted] = 0;
+
+   if (!current || (m_deficits[current->priority] == 0))
+     {
+       current = select_round_robin(requests);
+       std::map<unsigned int, unsigned int>::const_iterator w =
+         m_weights.find(current->priority);
+       m_deficits[current->priority] += (w != m_weights.end()) ? w->second : 1;
+     }
+   m_deficits[current->priority]--;
+   return current;
+ }
+ 
+ simple_bus_request *
+ simple_bus_arbiter::select_tdma(const simple_bus_request_vec &requests)
+ {
+   if (!m_tdma_table.empty() && (m_tdma_slot_time > SC_ZERO_TIME))
+     {
+       unsigned long long slot =
+         (unsigned long long)(sc_time_stamp() / m_tdma_slot_time);
+       unsigned int owner = m_tdma_table[slot % m_tdma_table.size()];
+       for (unsigned int i = 0; i < requests.size(); ++i)
+         if (requests[i]->priority == owner)
+           return requests[i];
+     }
+   // the owner of the slot is not requesting: work-conserving fallback
+   return select_by_priority(requests);
+ }
+ 
+ void simple_bus_arbiter::set_weight(unsigned int priority, unsigned int weight)
+ {
+   sc_assert(weight > 0);
+   m_weights[priority] = weight;
+ }
+ 
+ void simple_bus_arbiter::set_tdma_table(const std::vector<unsigned int> &table
+                                         , const sc_time &slot_time)
+ {
+   m_tdma_table = table;
+   m_tdma_slot_time = slot_time;
+ }
+ 
  void simple_bus_arbiter::report_arbitration_efficiency()
  {
+   if (!sb_metrics) {
+     sb_fprintf(stdout, "Métricas de arbitraje desactivadas en esta compilación (SIMPLE_BUS_NO_METRICS)\n");
+     return;
+   }
+
    sb_fprintf(stdout, "\n--- Métricas de Eficiencia de Arbitraje ---\n");
+   sb_fprintf(stdout, "Política de arbitraje: %s\n", simple_bus_arbiter_policy_str[m_policy]);
    
    // Tiempo promedio de arbitraje
    if (arbitration_decisions > 0) {
@@ -40,11 +40,20 @@
  
  #include <systemc.h>
  #include <map>
+ #include <vector>
  
  #include "simple_bus_types.h"
  #include "simple_bus_request.h"
  #include "simple_bus_arbiter_if.h"
  
+ // selection among requests that are not covered by the lock rules
+ enum simple_bus_arbiter_policy { SIMPLE_BUS_ARB_PRIORITY = 0 // lowest priority number wins
+                                  , SIMPLE_BUS_ARB_ROUND_ROBIN // cyclic over the priorities
+                                  , SIMPLE_BUS_ARB_WEIGHTED    // deficit round-robin
+                                  , SIMPLE_BUS_ARB_TDMA        // time-slot table
+ };
+ 
+ extern const char *simple_bus_arbiter_policy_str[4];
  
  class simple_bus_arbiter
    : public simple_bus_arbiter_if
@@ -53,21 +62,56 @@
  public:
    // constructor
    simple_bus_arbiter(sc_module_name name_
-                      , bool verbose = false)
+                      , bool verbose = false
+                      , simple_bus_arbiter_policy policy = SIMPLE_BUS_ARB_PRIORITY)
      : sc_module(name_)
      , m_verbose(verbose)
+     , m_policy(policy)
+     , m_last_granted(0)
+     , m_has_granted(false)
+     , m_tdma_slot_time(SC_ZERO_TIME)
      , total_arbitration_wait_time(SC_ZERO_TIME)
      , arbitration_decisions(0)
      , total_request_rejections(0)
    {}
  
    simple_bus_request *arbitrate(const simple_bus_request_vec &requests);
+
+   // SIMPLE_BUS_ARB_WEIGHTED: number of consecutive words a master may
+   // move per round (default 1)
+   void set_weight(unsigned int priority, unsigned int weight);
+
+   // SIMPLE_BUS_ARB_TDMA: slot i of the table lasts slot_time and belongs
+   // to the master with priority table[i]. A slot whose owner has no
+   // request is given away by priority.
+   void set_tdma_table(const std::vector<unsigned int> &table
+                       , const sc_time &slot_time);
    
    // Función para reportar métricas de eficiencia de arbitraje
    void report_arbitration_efficiency();
  
  private:
+   simple_bus_request *select_by_policy(const simple_bus_request_vec &requests);
+   simple_bus_request *select_by_priority(const simple_bus_request_vec &requests);
+   simple_bus_request *select_round_robin(const simple_bus_request_vec &requests);
+   simple_bus_request *select_weighted(const simple_bus_request_vec &requests);
+   simple_bus_request *select_tdma(const simple_bus_request_vec &requests);
+   void grant(const simple_bus_request *request
+              , unsigned int nr_requests
+              , const sc_time &arbitration_start_time);
+
    bool m_verbose;
+   simple_bus_arbiter_policy m_policy;
+
+   // round-robin and weighted state
+   unsigned int m_last_granted;
+   bool m_has_granted;
+   std::map<unsigned int, unsigned int> m_weights;
+   std::map<unsigned int, unsigned int> m_deficits;
+
+   // TDMA state
+   std::vector<unsigned int> m_tdma_table;
+   sc_time m_tdma_slot_time;
    
    // Variables para métricas de arbitraje
    sc_time total_arbitration_wait_time;
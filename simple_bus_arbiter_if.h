@@ -50,6 +50,11 @@ public:
   virtual simple_bus_request * 
     arbitrate(const simple_bus_request_vec &requests) = 0;
 
+  // the bus calls this whenever a request form enters or leaves its
+  // pending set, or its status or lock changes. An arbiter that keeps
+  // its own view of the candidates updates it here; others ignore it.
+  virtual void update(simple_bus_request *request, bool pending) {}
+
 }; // end class simple_bus_arbiter_if
 
 #endif
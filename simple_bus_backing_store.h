@@ -0,0 +1,437 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_backing_store.h : Sparse storage of the memory slaves.
+
+		 The contents are kept in 4 KiB pages which are allocated
+		 on the first write; reading a page that was never written
+		 returns zeros. Construction costs the same for 128 bytes
+		 and for 4 GB, and the resident size follows the pages
+		 actually touched. Pages are found through a two level
+		 table (1024 tables of 1024 pages), with the last page hit
+		 cached for bursts.
+
+		 The leading part of the store can instead be an mmap of
+		 a file (a memory image): copy-on-write, or shared so that
+		 writes go to the file. Mapped pages cost nothing until
+		 they are touched. Not available on Windows.
+
+		 save/restore write and read the contents in a compact
+		 form (the pages that are not all zero), see
+		 simple_bus_snapshot.h.
+
+		 Offsets are in bytes from the start of the memory and
+		 word aligned. A page stays at its address until the
+		 store is destroyed, so page pointers can be handed out
+		 for direct memory access; a region is a run of pages
+		 that is contiguous in host memory, see region().
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#ifndef __simple_bus_backing_store_h
+#define __simple_bus_backing_store_h
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "simple_bus_types.h"
+
+#define SIMPLE_BUS_PAGE_BITS 12
+#define SIMPLE_BUS_PAGE_SIZE (1u << SIMPLE_BUS_PAGE_BITS)       // bytes
+#define SIMPLE_BUS_PAGE_WORDS (SIMPLE_BUS_PAGE_SIZE / 4)
+#define SIMPLE_BUS_PAGE_TABLE_BITS 10
+#define SIMPLE_BUS_PAGE_TABLE_SIZE (1u << SIMPLE_BUS_PAGE_TABLE_BITS)
+
+class simple_bus_backing_store
+{
+public:
+  // size in bytes, up to 4 GB; nothing is allocated yet
+  explicit simple_bus_backing_store(uint64_t size)
+    : m_size(size)
+    , m_resident_pages(0)
+    , m_mapping((int *)0)
+    , m_mapped_pages(0)
+    , m_shared(false)
+    , m_last_page_nr(~0u)
+    , m_last_page((int *)0)
+  {
+    memset(m_tables, 0, sizeof(m_tables));
+  }
+
+  // destructor
+  ~simple_bus_backing_store();
+
+  uint64_t size() const { return m_size; }
+
+  // one word
+  int read(unsigned int offset) const;
+  void write(unsigned int offset, int data);
+
+  // runs of words, crossing pages where needed
+  void read(int *data, unsigned int offset, unsigned int words) const;
+  void write(const int *data, unsigned int offset, unsigned int words);
+
+  // a beat with byte strobes, see sb_write_lanes
+  void write_lanes(const int *data, unsigned int offset
+		   , unsigned int words, unsigned int byte_enable);
+
+  // the page holding offset, allocated if needed
+  int *page(unsigned int offset);
+
+  // direct memory access: the word at offset, allocated if needed, as
+  // part of the longest run of pages around it that is contiguous in
+  // host memory (the whole mapped image, or neighbouring heap pages
+  // that happen to be adjacent); first and last are the offsets of
+  // the first and last byte of the run, clipped to the size, and the
+  // result points to the word at first
+  int *region(unsigned int offset, unsigned int &first, unsigned int &last);
+
+  // footprint; mapped pages are not counted
+  unsigned int resident_pages() const { return m_resident_pages; }
+  uint64_t resident_bytes() const
+  { return (uint64_t)m_resident_pages * SIMPLE_BUS_PAGE_SIZE; }
+
+  // map a memory image over the start of the store, at most size
+  // bytes of it. shared: writes go to the file, which is extended to
+  // the size if needed; otherwise writes are private (copy-on-write).
+  // The image replaces what was written before in the mapped part.
+  // False if the file cannot be mapped.
+  bool map_file(const char *file_name, bool shared);
+  uint64_t mapped_bytes() const
+  { return (uint64_t)m_mapped_pages * SIMPLE_BUS_PAGE_SIZE; }
+
+  // contents: the size, then the pages that are not all zero.
+  // restore refuses a store with a shared mapping, which would write
+  // the snapshot into the image file
+  bool save(FILE *file) const;
+  bool restore(FILE *file);
+
+private:
+  // not copyable, pages are owned
+  simple_bus_backing_store(const simple_bus_backing_store &);
+  simple_bus_backing_store &operator=(const simple_bus_backing_store &);
+
+  int *find_page(unsigned int page_nr) const; // 0 if not allocated
+  int *heap_page(unsigned int page_nr) const;
+  static bool is_zero(const int *page);
+
+  uint64_t m_size;
+  int **m_tables[SIMPLE_BUS_PAGE_TABLE_SIZE];
+  unsigned int m_resident_pages;
+  int *m_mapping;               // pages [0, m_mapped_pages) of the store
+  unsigned int m_mapped_pages;
+  bool m_shared;                // the mapping writes through to its file
+  mutable unsigned int m_last_page_nr;
+  mutable int *m_last_page;
+
+}; // end class simple_bus_backing_store
+
+inline simple_bus_backing_store::~simple_bus_backing_store()
+{
+#if !defined(_WIN32)
+  if (m_mapping)
+    munmap(m_mapping, (size_t)m_mapped_pages * SIMPLE_BUS_PAGE_SIZE);
+#endif
+  for (unsigned int i = 0; i < SIMPLE_BUS_PAGE_TABLE_SIZE; ++i)
+    if (m_tables[i])
+      {
+	for (unsigned int j = 0; j < SIMPLE_BUS_PAGE_TABLE_SIZE; ++j)
+	  delete [] m_tables[i][j];
+	delete [] m_tables[i];
+      }
+}
+
+inline int *simple_bus_backing_store::heap_page(unsigned int page_nr) const
+{
+  int **table = m_tables[page_nr >> SIMPLE_BUS_PAGE_TABLE_BITS];
+  return table ? table[page_nr & (SIMPLE_BUS_PAGE_TABLE_SIZE - 1)] : (int *)0;
+}
+
+inline int *simple_bus_backing_store::find_page(unsigned int page_nr) const
+{
+  if (page_nr == m_last_page_nr)
+    return m_last_page;
+  if (page_nr < m_mapped_pages)
+    return m_mapping + (size_t)page_nr * SIMPLE_BUS_PAGE_WORDS;
+  int **table = m_tables[page_nr >> SIMPLE_BUS_PAGE_TABLE_BITS];
+  if (!table)
+    return (int *)0;
+  int *page = table[page_nr & (SIMPLE_BUS_PAGE_TABLE_SIZE - 1)];
+  if (page)
+    {
+      m_last_page_nr = page_nr;
+      m_last_page = page;
+    }
+  return page;
+}
+
+inline int *simple_bus_backing_store::page(unsigned int offset)
+{
+  sc_assert(offset < m_size);
+  unsigned int page_nr = offset >> SIMPLE_BUS_PAGE_BITS;
+  int *page = find_page(page_nr);
+  if (page)
+    return page;
+
+  int **&table = m_tables[page_nr >> SIMPLE_BUS_PAGE_TABLE_BITS];
+  if (!table)
+    table = new int *[SIMPLE_BUS_PAGE_TABLE_SIZE]();
+  page = new int [SIMPLE_BUS_PAGE_WORDS]();
+  table[page_nr & (SIMPLE_BUS_PAGE_TABLE_SIZE - 1)] = page;
+  ++m_resident_pages;
+  m_last_page_nr = page_nr;
+  m_last_page = page;
+  return page;
+}
+
+inline int *simple_bus_backing_store::region(unsigned int offset
+					     , unsigned int &first
+					     , unsigned int &last)
+{
+  int *base = page(offset);
+  unsigned int page_nr = offset >> SIMPLE_BUS_PAGE_BITS;
+  unsigned int first_nr = page_nr;
+  unsigned int last_nr = page_nr;
+  if (page_nr < m_mapped_pages)
+    {
+      first_nr = 0;
+      last_nr = m_mapped_pages - 1;
+    }
+  else
+    {
+      // heap pages are separate allocations: compare addresses only
+      const uintptr_t page_bytes = SIMPLE_BUS_PAGE_SIZE;
+      unsigned int nr_pages = (unsigned int)((m_size + SIMPLE_BUS_PAGE_SIZE - 1) / SIMPLE_BUS_PAGE_SIZE);
+      while ((first_nr > m_mapped_pages) &&
+	     ((uintptr_t)heap_page(first_nr - 1) ==
+	      (uintptr_t)base - (page_nr - first_nr + 1) * page_bytes))
+	--first_nr;
+      while ((last_nr + 1 < nr_pages) &&
+	     ((uintptr_t)heap_page(last_nr + 1) ==
+	      (uintptr_t)base + (last_nr + 1 - page_nr) * page_bytes))
+	++last_nr;
+    }
+  first = first_nr << SIMPLE_BUS_PAGE_BITS;
+  uint64_t end = ((uint64_t)last_nr + 1) << SIMPLE_BUS_PAGE_BITS;
+  last = (unsigned int)(((end < m_size) ? end : m_size) - 1);
+  return (int *)((uintptr_t)base - (uintptr_t)(page_nr - first_nr) * SIMPLE_BUS_PAGE_SIZE);
+}
+
+inline int simple_bus_backing_store::read(unsigned int offset) const
+{
+  const int *page = find_page(offset >> SIMPLE_BUS_PAGE_BITS);
+  return page ? page[(offset & (SIMPLE_BUS_PAGE_SIZE - 1)) / 4] : 0;
+}
+
+inline void simple_bus_backing_store::write(unsigned int offset, int data)
+{
+  page(offset)[(offset & (SIMPLE_BUS_PAGE_SIZE - 1)) / 4] = data;
+}
+
+inline void simple_bus_backing_store::read(int *data, unsigned int offset
+					   , unsigned int words) const
+{
+  while (words > 0)
+    {
+      unsigned int index = (offset & (SIMPLE_BUS_PAGE_SIZE - 1)) / 4;
+      unsigned int n = SIMPLE_BUS_PAGE_WORDS - index;
+      if (n > words)
+	n = words;
+      const int *page = find_page(offset >> SIMPLE_BUS_PAGE_BITS);
+      if (page)
+	memcpy(data, page + index, n*sizeof(int));
+      else
+	memset(data, 0, n*sizeof(int));
+      data += n;
+      offset += n*4;
+      words -= n;
+    }
+}
+
+inline void simple_bus_backing_store::write(const int *data, unsigned int offset
+					    , unsigned int words)
+{
+  while (words > 0)
+    {
+      unsigned int index = (offset & (SIMPLE_BUS_PAGE_SIZE - 1)) / 4;
+      unsigned int n = SIMPLE_BUS_PAGE_WORDS - index;
+      if (n > words)
+	n = words;
+      memcpy(page(offset) + index, data, n*sizeof(int));
+      data += n;
+      offset += n*4;
+      words -= n;
+    }
+}
+
+inline void simple_bus_backing_store::write_lanes(const int *data
+						  , unsigned int offset
+						  , unsigned int words
+						  , unsigned int byte_enable)
+{
+  // word by word: a beat may straddle a page boundary
+  for (unsigned int i = 0; i < words; ++i, offset += 4, byte_enable >>= 4)
+    if (byte_enable & SIMPLE_BUS_WORD_ENABLE)
+      sb_write_lanes(page(offset) + (offset & (SIMPLE_BUS_PAGE_SIZE - 1)) / 4
+		     , data + i, 1, byte_enable & SIMPLE_BUS_WORD_ENABLE);
+}
+
+inline bool simple_bus_backing_store::map_file(const char *file_name, bool shared)
+{
+#if defined(_WIN32)
+  return false;
+#else
+  if (m_mapping)
+    return false;
+  int fd = open(file_name, shared ? (O_RDWR | O_CREAT) : O_RDONLY, 0644);
+  if (fd < 0)
+    return false;
+  struct stat status;
+  uint64_t length = m_size;
+  bool ok = (fstat(fd, &status) == 0);
+  if (ok && shared && ((uint64_t)status.st_size < m_size))
+    ok = (ftruncate(fd, (off_t)m_size) == 0);
+  else if (ok && !shared && ((uint64_t)status.st_size < m_size))
+    length = (uint64_t)status.st_size;
+  // whole pages; the tail of the last one reads as zero
+  length = (length + SIMPLE_BUS_PAGE_SIZE - 1) & ~(uint64_t)(SIMPLE_BUS_PAGE_SIZE - 1);
+  if (!ok || (length == 0))
+    {
+      close(fd);
+      return ok;
+    }
+  void *mapping = mmap(0, (size_t)length, PROT_READ | PROT_WRITE
+		       , shared ? MAP_SHARED : MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED)
+    return false;
+  m_mapping = (int *)mapping;
+  m_mapped_pages = (unsigned int)(length / SIMPLE_BUS_PAGE_SIZE);
+  m_shared = shared;
+
+  // the image replaces the pages written before
+  for (unsigned int i = 0; i < SIMPLE_BUS_PAGE_TABLE_SIZE; ++i)
+    if (m_tables[i])
+      for (unsigned int j = 0; j < SIMPLE_BUS_PAGE_TABLE_SIZE; ++j)
+	{
+	  unsigned int page_nr = (i << SIMPLE_BUS_PAGE_TABLE_BITS) | j;
+	  if (!m_tables[i][j] || (page_nr >= m_mapped_pages))
+	    continue;
+	  delete [] m_tables[i][j];
+	  m_tables[i][j] = (int *)0;
+	  --m_resident_pages;
+	}
+  m_last_page_nr = ~0u;
+  m_last_page = (int *)0;
+  return true;
+#endif
+}
+
+inline bool simple_bus_backing_store::is_zero(const int *page)
+{
+  for (unsigned int i = 0; i < SIMPLE_BUS_PAGE_WORDS; ++i)
+    if (page[i])
+      return false;
+  return true;
+}
+
+// format, host byte order: uint64 size, then per page that is not all
+// zero a uint32 page number and its SIMPLE_BUS_PAGE_SIZE bytes, ended
+// by page number ~0
+inline bool simple_bus_backing_store::save(FILE *file) const
+{
+  bool ok = (fwrite(&m_size, sizeof(m_size), 1, file) == 1);
+  unsigned int nr_pages = (unsigned int)((m_size + SIMPLE_BUS_PAGE_SIZE - 1) / SIMPLE_BUS_PAGE_SIZE);
+  for (unsigned int page_nr = 0; ok && (page_nr < nr_pages); ++page_nr)
+    {
+      // skip absent page tables as a whole
+      if ((page_nr >= m_mapped_pages) &&
+	  !m_tables[page_nr >> SIMPLE_BUS_PAGE_TABLE_BITS])
+	{
+	  page_nr |= SIMPLE_BUS_PAGE_TABLE_SIZE - 1;
+	  continue;
+	}
+      const int *page = (page_nr < m_mapped_pages) ?
+	m_mapping + (size_t)page_nr * SIMPLE_BUS_PAGE_WORDS : heap_page(page_nr);
+      if (!page || is_zero(page))
+	continue;
+      uint32_t number = page_nr;
+      ok = (fwrite(&number, sizeof(number), 1, file) == 1) &&
+	(fwrite(page, SIMPLE_BUS_PAGE_SIZE, 1, file) == 1);
+    }
+  uint32_t end = ~0u;
+  return ok && (fwrite(&end, sizeof(end), 1, file) == 1);
+}
+
+inline bool simple_bus_backing_store::restore(FILE *file)
+{
+  if (m_mapping && m_shared)
+    return false;
+  uint64_t size;
+  if ((fread(&size, sizeof(size), 1, file) != 1) || (size != m_size))
+    return false;
+
+  // clear the current contents; zero pages are left alone so that
+  // copy-on-write mappings stay clean
+  for (unsigned int page_nr = 0; page_nr < m_mapped_pages; ++page_nr)
+    {
+      int *page = m_mapping + (size_t)page_nr * SIMPLE_BUS_PAGE_WORDS;
+      if (!is_zero(page))
+	memset(page, 0, SIMPLE_BUS_PAGE_SIZE);
+    }
+  for (unsigned int i = 0; i < SIMPLE_BUS_PAGE_TABLE_SIZE; ++i)
+    if (m_tables[i])
+      for (unsigned int j = 0; j < SIMPLE_BUS_PAGE_TABLE_SIZE; ++j)
+	if (m_tables[i][j])
+	  memset(m_tables[i][j], 0, SIMPLE_BUS_PAGE_SIZE);
+
+  for (;;)
+    {
+      uint32_t page_nr;
+      if (fread(&page_nr, sizeof(page_nr), 1, file) != 1)
+	return false;
+      if (page_nr == ~0u)
+	return true;
+      if ((uint64_t)page_nr * SIMPLE_BUS_PAGE_SIZE >= m_size)
+	return false;
+      if (fread(page(page_nr << SIMPLE_BUS_PAGE_BITS), SIMPLE_BUS_PAGE_SIZE, 1, file) != 1)
+	return false;
+    }
+}
+
+#endif
@@ -0,0 +1,88 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_bench.cpp : sc_main of the throughput benchmark.
+
+		 Runs a platform (default: the test bench of
+		 simple_bus_test.h for 1 ms of simulated time) and prints
+		 the wall-clock time and the simulated bus cycles per
+		 second. Built twice,
+		 as simple_bus_bench and as simple_bus_bench_release
+		 (-DSIMPLE_BUS_RELEASE), to compare the cost of logging
+		 and metrics; see simple_bus_config.h.
+
+		 "make bench_baseline" builds the baseline commit of
+		 this tree with the same flags and times both benches
+		 against it over the same simulated time (10000 ns,
+		 the only duration the baseline knows), repeated
+		 BENCH_RUNS times.
+
+		 The arguments are those of simple_bus, see
+		 simple_bus_platform.h.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+ #include <chrono>
+
+ #include "systemc.h"
+ #include "simple_bus_test.h"
+ #include "simple_bus_platform.h"
+ 
+ int sc_main(int argc, char *argv[])
+ {
+   simple_bus_platform_config config;
+   config.duration = 1e6; // ns
+   if (!config.parse_arguments(argc, argv)) {
+     simple_bus_platform_config::usage(argv[0]);
+     return 1;
+   }
+
+   simple_bus_test top("top", config);
+
+   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+   sc_start(config.duration, SC_NS);
+   std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+   sc_stop();
+
+   double wall_sec = std::chrono::duration<double>(stop - start).count();
+   double cycles = config.duration / config.clock_period;
+
+   sb_fprintf(stdout, "\n--- Benchmark simple_bus ---\n");
+   sb_fprintf(stdout, "Logging: %s, métricas: %s\n"
+              , sb_logging ? "activado" : "desactivado"
+              , sb_metrics ? "activadas" : "desactivadas");
+   sb_fprintf(stdout, "Tiempo simulado: %.0f ns (%.0f ciclos)\n", config.duration, cycles);
+   sb_fprintf(stdout, "Tiempo real: %.3f s\n", wall_sec);
+   if (wall_sec > 0.0)
+     sb_fprintf(stdout, "Ciclos simulados por segundo: %.0f\n", cycles / wall_sec);
+
+   return 0;
+ }
@@ -0,0 +1,466 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_cache.cpp : A set-associative cache in front of a slave.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#include <string.h>
+#include <algorithm>
+
+#include "simple_bus_cache.h"
+
+const char *simple_bus_cache_policy_str[2] = { "write-back"
+					       , "write-through"
+};
+
+simple_bus_cache::simple_bus_cache(sc_module_name name_
+				   , unsigned int size
+				   , unsigned int line_size
+				   , unsigned int nr_ways
+				   , simple_bus_cache_policy policy
+				   , unsigned int hit_wait_states
+				   , unsigned int miss_wait_states
+				   , const sc_time &clock_period)
+  : sc_module(name_)
+  , m_size(size)
+  , m_line_size(line_size)
+  , m_line_words(line_size / 4)
+  , m_nr_ways(nr_ways)
+  , m_nr_sets((line_size && nr_ways) ? size / (line_size * nr_ways) : 0)
+  , m_policy(policy)
+  , m_hit_wait_states(hit_wait_states)
+  , m_miss_wait_states(miss_wait_states)
+  , m_clock_period(clock_period)
+  , m_start_address(0)
+  , m_use_count(0)
+  , m_busy(false)
+  , m_ready_time(SC_ZERO_TIME)
+  , m_reads(0)
+  , m_read_misses(0)
+  , m_writes(0)
+  , m_write_misses(0)
+  , m_fills(0)
+  , m_write_backs(0)
+{
+  sc_assert((m_line_size >= 4) && !(m_line_size & (m_line_size - 1)));
+  sc_assert(m_nr_ways > 0);
+  sc_assert((m_nr_sets > 0) && !(m_nr_sets & (m_nr_sets - 1)) &&
+	    (m_nr_sets * m_nr_ways * m_line_size == m_size));
+
+  cache_line empty = { false, false, 0, 0 };
+  m_lines.assign(m_nr_sets * m_nr_ways, empty);
+  m_data.assign(m_lines.size() * m_line_words, 0);
+  set_statistics zero = { 0, 0, 0 };
+  m_set_statistics.assign(m_nr_sets, zero);
+}
+
+void simple_bus_cache::end_of_elaboration()
+{
+  m_start_address = backend_port->start_address();
+  // a beat must stay within one line
+  sc_assert(backend_port->data_width() <= m_line_size);
+}
+
+void simple_bus_cache::end_of_simulation()
+{
+  report_cache_statistics();
+}
+
+//----------------------------------------------------------------------------
+//-- lines
+//----------------------------------------------------------------------------
+
+int simple_bus_cache::find(unsigned int address) const
+{
+  unsigned int line_nr = (address - m_start_address) / m_line_size;
+  unsigned int set = line_nr & (m_nr_sets - 1);
+  unsigned int tag = line_nr / m_nr_sets;
+  for (unsigned int way = 0; way < m_nr_ways; ++way)
+    {
+      const cache_line &line = m_lines[set * m_nr_ways + way];
+      if (line.valid && (line.tag == tag))
+	return set * m_nr_ways + way;
+    }
+  return -1;
+}
+
+int *simple_bus_cache::word(unsigned int index, unsigned int address)
+{
+  return &m_data[index * m_line_words +
+		 ((address - m_start_address) % m_line_size) / 4];
+}
+
+unsigned int simple_bus_cache::line_address(unsigned int index) const
+{
+  unsigned int set = index / m_nr_ways;
+  return m_start_address +
+    (m_lines[index].tag * m_nr_sets + set) * m_line_size;
+}
+
+void simple_bus_cache::write_back(unsigned int index)
+{
+  int *data = &m_data[index * m_line_words];
+  unsigned int address = line_address(index);
+  if (!backend_port->burst_write(data, address, m_line_words))
+    for (unsigned int i = 0; i < m_line_words; ++i)
+      backend_port->direct_write(data + i, address + 4*i);
+  m_lines[index].dirty = false;
+  ++m_write_backs;
+}
+
+// the least recently used line of the set gets the line of address
+unsigned int simple_bus_cache::fill(unsigned int address, bool &written_back)
+{
+  unsigned int line_nr = (address - m_start_address) / m_line_size;
+  unsigned int set = line_nr & (m_nr_sets - 1);
+  unsigned int index = set * m_nr_ways;
+  for (unsigned int way = 0; way < m_nr_ways; ++way)
+    {
+      const cache_line &line = m_lines[set * m_nr_ways + way];
+      if (!line.valid)
+	{
+	  index = set * m_nr_ways + way;
+	  break;
+	}
+      if (line.last_use < m_lines[index].last_use)
+	index = set * m_nr_ways + way;
+    }
+
+  written_back = false;
+  cache_line &line = m_lines[index];
+  if (line.valid)
+    {
+      if (sb_metrics)
+	m_set_statistics[set].evictions++;
+      if (line.dirty)
+	{
+	  write_back(index);
+	  written_back = true;
+	}
+    }
+
+  int *data = &m_data[index * m_line_words];
+  unsigned int start = m_start_address + line_nr * m_line_size;
+  if (!backend_port->burst_read(data, start, m_line_words))
+    for (unsigned int i = 0; i < m_line_words; ++i)
+      backend_port->direct_read(data + i, start + 4*i);
+  line.valid = true;
+  line.dirty = false;
+  line.tag = line_nr / m_nr_sets;
+  line.last_use = ++m_use_count;
+  ++m_fills;
+  return index;
+}
+
+//----------------------------------------------------------------------------
+//-- timing
+//----------------------------------------------------------------------------
+
+// start of an access: updates the lines, returns its wait states
+unsigned int simple_bus_cache::lookup(unsigned int address, bool do_write)
+{
+  int index = find(address);
+  if (sb_metrics)
+    {
+      set_statistics &statistics =
+	m_set_statistics[((address - m_start_address) / m_line_size) & (m_nr_sets - 1)];
+      statistics.accesses++;
+      if (index < 0)
+	statistics.misses++;
+      if (do_write)
+	{
+	  m_writes++;
+	  if (index < 0)
+	    m_write_misses++;
+	}
+      else
+	{
+	  m_reads++;
+	  if (index < 0)
+	    m_read_misses++;
+	}
+    }
+
+  if (index >= 0)
+    {
+      // a write-through write hit updates the line; its backend write
+      // is posted and not waited for
+      m_lines[index].last_use = ++m_use_count;
+      return m_hit_wait_states;
+    }
+  if (do_write && (m_policy == SIMPLE_BUS_CACHE_WRITE_THROUGH))
+    return m_miss_wait_states; // no allocation, the write goes to the backend
+  bool written_back;
+  fill(address, written_back);
+  return written_back ? 2 * m_miss_wait_states : m_miss_wait_states;
+}
+
+// same protocol as simple_bus_slow_mem_clockless: the bus calls on every
+// falling edge, the call wait_states clock periods after the first one
+// completes the access
+simple_bus_status simple_bus_cache::access(unsigned int address, bool do_write)
+{
+  const sc_time &now = sc_time_stamp();
+  if (m_busy && (now <= m_ready_time))
+    {
+      if (now < m_ready_time)
+	return SIMPLE_BUS_WAIT;
+      m_busy = false;
+      return SIMPLE_BUS_OK;
+    }
+
+  unsigned int wait_states = lookup(address, do_write);
+  if (wait_states == 0)
+    {
+      m_busy = false;
+      return SIMPLE_BUS_OK;
+    }
+  m_busy = true;
+  m_ready_time = now + m_clock_period * (double)wait_states;
+  return SIMPLE_BUS_WAIT;
+}
+
+void simple_bus_cache::write_through(const int *data, unsigned int address
+				     , unsigned int words, unsigned int byte_enable)
+{
+  for (unsigned int i = 0; i < words; ++i, byte_enable >>= 4)
+    {
+      unsigned int lanes = byte_enable & SIMPLE_BUS_WORD_ENABLE;
+      int value = data[i];
+      if (!lanes)
+	continue;
+      if (lanes != SIMPLE_BUS_WORD_ENABLE)
+	{
+	  backend_port->direct_read(&value, address + 4*i);
+	  sb_write_lanes(&value, data + i, 1, lanes);
+	}
+      backend_port->direct_write(&value, address + 4*i);
+    }
+}
+
+//----------------------------------------------------------------------------
+//-- Slave Interface
+//----------------------------------------------------------------------------
+
+simple_bus_status simple_bus_cache::read_beat(int *data
+					      , unsigned int address
+					      , unsigned int words)
+{
+  sc_assert(words*4 <= data_width());
+  simple_bus_status status = access(address, false);
+  if (status == SIMPLE_BUS_OK)
+    {
+      int index = find(address);
+      sc_assert(index >= 0);
+      memcpy(data, word(index, address), words*sizeof(int));
+    }
+  return status;
+}
+
+simple_bus_status simple_bus_cache::write_beat(int *data
+					       , unsigned int address
+					       , unsigned int words
+					       , unsigned int byte_enable)
+{
+  sc_assert(words*4 <= data_width());
+  simple_bus_status status = access(address, true);
+  if (status == SIMPLE_BUS_OK)
+    {
+      int index = find(address);
+      if (index >= 0)
+	{
+	  sb_write_lanes(word(index, address), data, words, byte_enable);
+	  if (m_policy == SIMPLE_BUS_CACHE_WRITE_BACK)
+	    m_lines[index].dirty = true;
+	}
+      if (m_policy == SIMPLE_BUS_CACHE_WRITE_THROUGH)
+	write_through(data, address, words, byte_enable);
+    }
+  return status;
+}
+
+simple_bus_status simple_bus_cache::read(int *data, unsigned int address)
+{
+  return read_beat(data, address, 1);
+}
+
+simple_bus_status simple_bus_cache::write(int *data, unsigned int address)
+{
+  return write_beat(data, address, 1, SIMPLE_BUS_WORD_ENABLE);
+}
+
+bool simple_bus_cache::direct_read(int *data, unsigned int address)
+{
+  int index = find(address);
+  if (index < 0)
+    return backend_port->direct_read(data, address);
+  *data = *word(index, address);
+  return true;
+}
+
+bool simple_bus_cache::direct_write(int *data, unsigned int address)
+{
+  int index = find(address);
+  if (index >= 0)
+    {
+      *word(index, address) = *data;
+      if (m_policy == SIMPLE_BUS_CACHE_WRITE_BACK)
+	{
+	  m_lines[index].dirty = true;
+	  return true;
+	}
+    }
+  return backend_port->direct_write(data, address);
+}
+
+unsigned int simple_bus_cache::data_width() const
+{
+  return backend_port->data_width();
+}
+
+// the hit latency: loosely-timed transfers go through the direct
+// interface, which neither fills lines nor charges misses
+unsigned int simple_bus_cache::nr_wait_states() const
+{
+  return m_hit_wait_states;
+}
+
+unsigned int simple_bus_cache::start_address() const
+{
+  return backend_port->start_address();
+}
+
+unsigned int simple_bus_cache::end_address() const
+{
+  return backend_port->end_address();
+}
+
+//----------------------------------------------------------------------------
+//-- checkpoints
+//----------------------------------------------------------------------------
+
+bool simple_bus_cache::snapshot_ready() const
+{
+  return !m_busy || (sc_time_stamp() > m_ready_time);
+}
+
+// format: uint32 sets, ways and line size, per line uint32 flags
+// (1 valid, 2 dirty) and tag, then the data of all lines
+bool simple_bus_cache::save_state(FILE *file) const
+{
+  uint32_t geometry[3] = { m_nr_sets, m_nr_ways, m_line_size };
+  if (fwrite(geometry, sizeof(geometry), 1, file) != 1)
+    return false;
+  for (unsigned int i = 0; i < m_lines.size(); ++i)
+    {
+      uint32_t line[2] = { (m_lines[i].valid ? 1u : 0u) | (m_lines[i].dirty ? 2u : 0u)
+			   , m_lines[i].tag };
+      if (fwrite(line, sizeof(line), 1, file) != 1)
+	return false;
+    }
+  return fwrite(&m_data[0], sizeof(int), m_data.size(), file) == m_data.size();
+}
+
+bool simple_bus_cache::restore_state(FILE *file)
+{
+  uint32_t geometry[3];
+  if ((fread(geometry, sizeof(geometry), 1, file) != 1) ||
+      (geometry[0] != m_nr_sets) || (geometry[1] != m_nr_ways) ||
+      (geometry[2] != m_line_size))
+    return false;
+  for (unsigned int i = 0; i < m_lines.size(); ++i)
+    {
+      uint32_t line[2];
+      if (fread(line, sizeof(line), 1, file) != 1)
+	return false;
+      m_lines[i].valid = (line[0] & 1) != 0;
+      m_lines[i].dirty = (line[0] & 2) != 0;
+      m_lines[i].tag = line[1];
+      m_lines[i].last_use = 0;
+    }
+  m_busy = false;
+  return fread(&m_data[0], sizeof(int), m_data.size(), file) == m_data.size();
+}
+
+//----------------------------------------------------------------------------
+//-- report
+//----------------------------------------------------------------------------
+
+static double hit_rate(uint64_t accesses, uint64_t misses)
+{
+  return accesses ? 100.0 * (accesses - misses) / accesses : 0.0;
+}
+
+void simple_bus_cache::report_cache_statistics()
+{
+  if (!sb_metrics) {
+    sb_fprintf(stdout, "Estadísticas de caché desactivadas en esta compilación (SIMPLE_BUS_NO_METRICS)\n");
+    return;
+  }
+
+  sb_fprintf(stdout, "\n--- Estadísticas de caché %s ---\n", name());
+  sb_fprintf(stdout, "Geometría: %u bytes, %u vías, líneas de %u bytes, %u conjuntos, %s\n",
+	     m_size, m_nr_ways, m_line_size, m_nr_sets, simple_bus_cache_policy_str[m_policy]);
+  sb_fprintf(stdout, "Lecturas: %llu (aciertos %.2f%%)\n", (unsigned long long)m_reads,
+	     hit_rate(m_reads, m_read_misses));
+  sb_fprintf(stdout, "Escrituras: %llu (aciertos %.2f%%)\n", (unsigned long long)m_writes,
+	     hit_rate(m_writes, m_write_misses));
+  if (m_reads + m_writes > 0)
+    sb_fprintf(stdout, "Tasa de aciertos: %.2f%%\n",
+	       hit_rate(m_reads + m_writes, m_read_misses + m_write_misses));
+  else
+    sb_fprintf(stdout, "No se realizaron accesos a la caché\n");
+  sb_fprintf(stdout, "Líneas cargadas: %llu, escritas de vuelta: %llu\n",
+	     (unsigned long long)m_fills, (unsigned long long)m_write_backs);
+
+  // per set: the sets with the most misses
+  std::vector<unsigned int> sets;
+  for (unsigned int i = 0; i < m_nr_sets; ++i)
+    if (m_set_statistics[i].accesses > 0)
+      sets.push_back(i);
+  if (sets.empty())
+    return;
+  unsigned int nr_shown = std::min<unsigned int>(sets.size(), 16);
+  std::partial_sort(sets.begin(), sets.begin() + nr_shown, sets.end(),
+		    [this](unsigned int a, unsigned int b)
+		    { return m_set_statistics[a].misses > m_set_statistics[b].misses; });
+  sb_fprintf(stdout, "Conjuntos con más fallos (%u de %u usados):\n",
+	     nr_shown, (unsigned int)sets.size());
+  for (unsigned int i = 0; i < nr_shown; ++i)
+    {
+      const set_statistics &statistics = m_set_statistics[sets[i]];
+      sb_fprintf(stdout, "  conjunto %u: accesos %llu, aciertos %.2f%%, expulsiones %llu\n",
+		 sets[i], (unsigned long long)statistics.accesses,
+		 hit_rate(statistics.accesses, statistics.misses),
+		 (unsigned long long)statistics.evictions);
+    }
+}
@@ -0,0 +1,181 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_cache.h : A set-associative cache in front of a slave.
+
+		 The cache is a slave itself; backend_port connects the
+		 slave it caches, whose address range it takes over.
+		 Geometry: size and line size in bytes, number of ways,
+		 LRU replacement. Write-back caches allocate on writes;
+		 write-through caches do not, and every write goes to the
+		 backend.
+
+		 Timing: an access that stays in the cache takes
+		 hit_wait_states, one that needs the backend (line fill,
+		 write-through write miss) miss_wait_states, plus as many
+		 again if a dirty line is written back first. A
+		 write-through write hit takes hit_wait_states: the
+		 backend write is posted. Line fills and write-backs use
+		 the burst entry points of the backend, or its direct
+		 interface when it has no native bursts; the wait states
+		 of the backend itself are not used.
+
+		 The direct interface is untimed but coherent with the
+		 cache; there is no direct memory access.
+		 nr_wait_states() is the hit latency (hit_wait_states):
+		 loosely-timed transfers use the direct interface and
+		 are charged as hits, misses included.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#ifndef __simple_bus_cache_h
+#define __simple_bus_cache_h
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+#include <systemc.h>
+
+#include "simple_bus_types.h"
+#include "simple_bus_slave_if.h"
+#include "simple_bus_snapshot.h"
+
+enum simple_bus_cache_policy { SIMPLE_BUS_CACHE_WRITE_BACK = 0
+			       , SIMPLE_BUS_CACHE_WRITE_THROUGH
+};
+
+extern const char *simple_bus_cache_policy_str[2];
+
+class simple_bus_cache
+  : public simple_bus_slave_if
+  , public simple_bus_snapshot_if
+  , public sc_module
+{
+public:
+  // ports
+  sc_port<simple_bus_slave_if> backend_port;
+
+  // constructor
+  simple_bus_cache(sc_module_name name_
+		   , unsigned int size
+		   , unsigned int line_size
+		   , unsigned int nr_ways
+		   , simple_bus_cache_policy policy
+		   , unsigned int hit_wait_states
+		   , unsigned int miss_wait_states
+		   , const sc_time &clock_period);
+
+  // SystemC callbacks
+  void end_of_elaboration();
+  void end_of_simulation();
+
+  // direct Slave Interface
+  bool direct_read(int *data, unsigned int address);
+  bool direct_write(int *data, unsigned int address);
+
+  // Slave Interface
+  simple_bus_status read(int *data, unsigned int address);
+  simple_bus_status write(int *data, unsigned int address);
+  unsigned int data_width() const;
+  simple_bus_status read_beat(int *data, unsigned int address
+			      , unsigned int words);
+  simple_bus_status write_beat(int *data, unsigned int address
+			       , unsigned int words, unsigned int byte_enable);
+  unsigned int nr_wait_states() const;
+
+  unsigned int start_address() const;
+  unsigned int end_address() const;
+
+  // checkpoints: tags and contents of the lines
+  bool snapshot_ready() const;
+  bool save_state(FILE *file) const;
+  bool restore_state(FILE *file);
+
+  // hit rate and the sets with the most misses
+  void report_cache_statistics();
+
+private:
+  struct cache_line
+  {
+    bool valid;
+    bool dirty;
+    unsigned int tag;
+    uint64_t last_use; // LRU
+  };
+
+  struct set_statistics
+  {
+    uint64_t accesses;
+    uint64_t misses;
+    uint64_t evictions;
+  };
+
+  simple_bus_status access(unsigned int address, bool do_write);
+  unsigned int lookup(unsigned int address, bool do_write);
+  int find(unsigned int address) const; // line index, -1 on a miss
+  int *word(unsigned int index, unsigned int address);
+  unsigned int fill(unsigned int address, bool &written_back);
+  void write_back(unsigned int index);
+  unsigned int line_address(unsigned int index) const;
+  void write_through(const int *data, unsigned int address
+		     , unsigned int words, unsigned int byte_enable);
+
+  unsigned int m_size;
+  unsigned int m_line_size;
+  unsigned int m_line_words;
+  unsigned int m_nr_ways;
+  unsigned int m_nr_sets;
+  simple_bus_cache_policy m_policy;
+  unsigned int m_hit_wait_states;
+  unsigned int m_miss_wait_states;
+  sc_time m_clock_period;
+  unsigned int m_start_address; // of the backend
+
+  std::vector<cache_line> m_lines; // set * m_nr_ways + way
+  std::vector<int> m_data;         // line index * m_line_words + word
+  uint64_t m_use_count;
+
+  // access in progress
+  bool m_busy;
+  sc_time m_ready_time;
+
+  // statistics
+  uint64_t m_reads;
+  uint64_t m_read_misses;
+  uint64_t m_writes;
+  uint64_t m_write_misses;
+  uint64_t m_fills;
+  uint64_t m_write_backs;
+  std::vector<set_statistics> m_set_statistics;
+
+}; // end class simple_bus_cache
+
+#endif
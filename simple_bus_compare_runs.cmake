@@ -0,0 +1,54 @@
+###############################################################################
+#
+# Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+# more contributor license agreements.  See the NOTICE file distributed
+# with this work for additional information regarding copyright ownership.
+# Accellera licenses this file to you under the Apache License, Version 2.0
+# (the "License"); you may not use this file except in compliance with the
+# License.  You may obtain a copy of the License at
+#
+#  http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+# implied.  See the License for the specific language governing
+# permissions and limitations under the License.
+#
+###############################################################################
+
+###############################################################################
+#
+# simple_bus_compare_runs.cmake --
+# Runs TEST_EXE with the arguments in RUN_A and in RUN_B (separated by
+# blanks) and fails unless both runs print the same output.
+#
+#   cmake -DTEST_EXE=... -DRUN_A=... -DRUN_B=... -P simple_bus_compare_runs.cmake
+#
+###############################################################################
+
+###############################################################################
+#
+# MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+# changes you are making here.
+#
+#     Name, Affiliation, Date:
+# Description of Modification:
+#
+###############################################################################
+
+foreach (run A B)
+  separate_arguments (arguments UNIX_COMMAND "${RUN_${run}}")
+  execute_process (COMMAND ${TEST_EXE} ${arguments}
+                   OUTPUT_VARIABLE output_${run}
+                   RESULT_VARIABLE result_${run})
+  if (NOT result_${run} EQUAL 0)
+    message (FATAL_ERROR "${TEST_EXE} ${RUN_${run}} failed: ${result_${run}}")
+  endif ()
+endforeach ()
+
+if (NOT output_A STREQUAL output_B)
+  file (WRITE run_a.log "${output_A}")
+  file (WRITE run_b.log "${output_B}")
+  message (FATAL_ERROR "the runs differ, see run_a.log and run_b.log")
+endif ()
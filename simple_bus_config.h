@@ -0,0 +1,68 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_config.h : Compile-time switches of the bus models.
+
+		 -DSIMPLE_BUS_NO_LOGGING removes the verbose output of
+		 the bus, crossbar and arbiters, -DSIMPLE_BUS_NO_METRICS
+		 removes the metric, latency and arbitration statistics;
+		 -DSIMPLE_BUS_RELEASE implies both. The switches are
+		 constexpr flags tested in front of the run-time checks,
+		 so the disabled code is still compiled (and kept free
+		 of errors) but the optimizer drops it.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#ifndef __simple_bus_config_h
+#define __simple_bus_config_h
+
+#if defined(SIMPLE_BUS_RELEASE)
+#  if !defined(SIMPLE_BUS_NO_LOGGING)
+#    define SIMPLE_BUS_NO_LOGGING
+#  endif
+#  if !defined(SIMPLE_BUS_NO_METRICS)
+#    define SIMPLE_BUS_NO_METRICS
+#  endif
+#endif
+
+#if defined(SIMPLE_BUS_NO_LOGGING)
+constexpr bool sb_logging = false;
+#else
+constexpr bool sb_logging = true;
+#endif
+
+#if defined(SIMPLE_BUS_NO_METRICS)
+constexpr bool sb_metrics = false;
+#else
+constexpr bool sb_metrics = true;
+#endif
+
+#endif
@@ -0,0 +1,595 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_crossbar.cpp : The multi-layer bus (crossbar).
+
+		 The main_action process is active at falling clock edge.
+		 It hands every pending request to the layer of the slave
+		 its current address decodes to. Each layer then works
+		 like simple_bus: when it has no current request, its
+		 arbiter selects one of the candidates, and one word is
+		 transferred per cycle (or the slave wait state is
+		 monitored). Bursts are re-arbitrated per word, and a
+		 burst that crosses a slave boundary moves on to the
+		 layer of the next slave.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#include "simple_bus_crossbar.h"
+
+//----------------------------------------------------------------------------
+//-- SystemC callback methods
+//----------------------------------------------------------------------------
+
+void simple_bus_crossbar::end_of_elaboration()
+{
+  simple_bus_build_decode_table(m_decode_table, slave_port);
+
+  // the loosely-timed interface computes delays from the clock period
+  sc_clock *clk = dynamic_cast<sc_clock *>(clock.get_interface());
+  if (clk)
+    m_clock_period = clk->period();
+
+  // forward DMI invalidations of the slaves to our own listeners
+  for (unsigned int i = 0; i < m_decode_table.size(); ++i)
+    m_decode_table[i].slave->register_dmi_listener(this);
+
+  // perform a static check for overlapping memory areas of the slaves
+  if (simple_bus_check_overlaps(m_decode_table) > 0)
+    exit(1);
+
+  sc_assert((arbiter_port.size() == 1) ||
+	    (arbiter_port.size() == slave_port.size()));
+  m_layers.resize(m_decode_table.size());
+  for (unsigned int i = 0; i < m_decode_table.size(); ++i)
+    {
+      simple_bus_crossbar_layer &layer = m_layers[i];
+      layer.slave = &m_decode_table[i];
+      layer.arbiter = (arbiter_port.size() == 1) ? arbiter_port[0] :
+	arbiter_port[m_decode_table[i].port_index];
+      layer.current = (simple_bus_request *)0;
+      layer.active_cycles = 0;
+      layer.words = 0;
+    }
+}
+
+void simple_bus_crossbar::end_of_simulation()
+{
+  m_metrics.simulation_time.set(sb_time_ps(sc_time_stamp()));
+  report_bus_utilization();
+}
+
+//----------------------------------------------------------------------------
+//-- process
+//----------------------------------------------------------------------------
+
+void simple_bus_crossbar::main_action()
+{
+  unsigned int i;
+  m_cycles++;
+
+  // hand the pending requests (slot mask, in slot order) to the
+  // layers of their slaves
+  for (i = 0; i < m_layers.size(); ++i)
+    m_layers[i].queue.clear();
+  for (unsigned int w = 0; w < m_pending_mask.size(); ++w)
+    {
+      unsigned long long bits = m_pending_mask[w];
+      while (bits)
+	{
+	  simple_bus_request *request = m_requests[w*64 + sb_lowest_bit(bits)];
+	  bits &= bits - 1;
+
+	  if ((request->address)%4 != 0 ) {// address not word alligned
+	    sb_fprintf(stdout, "  BUS ERROR --> address %04X not word alligned\n",request->address);
+	    set_status(request, SIMPLE_BUS_ERROR);
+	    request->transfer_done.notify();
+	    continue;
+	  }
+	  simple_bus_crossbar_layer *layer = get_layer(request->address);
+	  if (!layer) {
+	    sb_fprintf(stdout, "  BUS ERROR --> no slave for address %04X \n",request->address);
+	    set_status(request, SIMPLE_BUS_ERROR);
+	    request->transfer_done.notify();
+	    continue;
+	  }
+	  if (layer->current != request)
+	    layer->queue.push_back(request);
+	}
+    }
+
+  // every layer selects and serves its own request
+  bool active = false;
+  for (i = 0; i < m_layers.size(); ++i)
+    {
+      simple_bus_crossbar_layer &layer = m_layers[i];
+      if (!layer.current && !layer.queue.empty())
+	{
+	  if (sb_metrics) {
+	    m_metrics.arbitrations.add(1);
+	    m_metrics.arbitration_rejections.add(layer.queue.size() - 1);
+	  }
+	  layer.current = layer.arbiter->arbitrate(layer.queue);
+	}
+      else if (sb_logging && layer.current && m_verbose)
+	// monitor slave wait states
+	sb_fprintf(stdout, "%s SLV [%d]\n", sc_time_stamp().to_string().c_str(),
+		   layer.current->address);
+      if (layer.current)
+	{
+	  active = true;
+	  layer.active_cycles++;
+	  handle_request(layer);
+	}
+    }
+  // the crossbar is busy while any of its layers is
+  if (sb_metrics && active)
+    m_metrics.active_time.add(sb_time_ps(m_clock_period));
+
+  clear_locks();
+}
+
+//----------------------------------------------------------------------------
+//-- direct BUS interface
+//----------------------------------------------------------------------------
+
+bool simple_bus_crossbar::direct_read(int *data, unsigned int address)
+{
+  if (address%4 != 0 ) {// address not word alligned
+    sb_fprintf(stdout, "  BUS ERROR --> address %04X not word alligned\n",address);
+    return false; 
+  }
+  simple_bus_crossbar_layer *layer = get_layer(address);
+  if (!layer) return false;
+  return layer->slave->slave->direct_read(data, address);
+}
+
+bool simple_bus_crossbar::direct_write(int *data, unsigned int address)
+{
+  if (address%4 != 0 ) {// address not word alligned
+    sb_fprintf(stdout, "  BUS ERROR --> address %04X not word alligned\n",address);
+    return false; 
+  }
+  simple_bus_crossbar_layer *layer = get_layer(address);
+  if (!layer) return false;
+  return layer->slave->slave->direct_write(data, address);
+}
+
+bool simple_bus_crossbar::get_direct_mem_ptr(unsigned int address, simple_bus_dmi &dmi)
+{
+  if (address%4 != 0 ) {// address not word alligned
+    sb_fprintf(stdout, "  BUS ERROR --> address %04X not word alligned\n",address);
+    return false; 
+  }
+  simple_bus_crossbar_layer *layer = get_layer(address);
+  if (!layer) return false;
+  return layer->slave->slave->get_direct_mem_ptr(address, dmi);
+}
+
+void simple_bus_crossbar::register_dmi_listener(simple_bus_dmi_invalidate_if *listener)
+{
+  m_dmi_listeners.add(listener);
+}
+
+void simple_bus_crossbar::invalidate_direct_mem_ptr(unsigned int start_address
+						    , unsigned int end_address)
+{
+  m_dmi_listeners.invalidate(start_address, end_address);
+}
+
+//----------------------------------------------------------------------------
+//-- non-blocking BUS interface
+//----------------------------------------------------------------------------
+
+void simple_bus_crossbar::read(unsigned int unique_priority
+			       , int *data
+			       , unsigned int address
+			       , bool lock)
+{
+  if (sb_logging && m_verbose)
+    sb_fprintf(stdout, "%s %s : read(%d) @ %x\n",
+	       sc_time_stamp().to_string().c_str(), name(), unique_priority, address);
+
+  simple_bus_request *request = get_request(unique_priority);
+
+  // abort when the request is still not finished
+  sc_assert((request->status == SIMPLE_BUS_OK) ||
+	    (request->status == SIMPLE_BUS_ERROR));
+
+  post_request(request, false, data, address, address,
+	       SIMPLE_BUS_WORD_ENABLE, lock);
+}
+
+void simple_bus_crossbar::write(unsigned int unique_priority
+				, int *data
+				, unsigned int address
+				, bool lock)
+{
+  if (sb_logging && m_verbose)
+    sb_fprintf(stdout, "%s %s : write(%d) @ %x\n",
+	       sc_time_stamp().to_string().c_str(), name(), unique_priority, address);
+
+  simple_bus_request *request = get_request(unique_priority);
+
+  // abort when the request is still not finished
+  sc_assert((request->status == SIMPLE_BUS_OK) ||
+	    (request->status == SIMPLE_BUS_ERROR));
+
+  post_request(request, true, data, address, address,
+	       SIMPLE_BUS_WORD_ENABLE, lock);
+}
+
+void simple_bus_crossbar::write_bytes(unsigned int unique_priority
+				      , int *data
+				      , unsigned int address
+				      , unsigned int byte_enable
+				      , bool lock)
+{
+  if (sb_logging && m_verbose)
+    sb_fprintf(stdout, "%s %s : write_bytes(%d) @ %x [%x]\n",
+	       sc_time_stamp().to_string().c_str(), name(), unique_priority, address,
+	       byte_enable);
+
+  simple_bus_request *request = get_request(unique_priority);
+
+  // abort when the request is still not finished
+  sc_assert((request->status == SIMPLE_BUS_OK) ||
+	    (request->status == SIMPLE_BUS_ERROR));
+
+  post_request(request, true, data, address, address,
+	       byte_enable & SIMPLE_BUS_WORD_ENABLE, lock);
+}
+
+simple_bus_status simple_bus_crossbar::get_status(unsigned int unique_priority)
+{
+  return get_request(unique_priority)->status;
+}
+
+//----------------------------------------------------------------------------
+//-- blocking BUS interface
+//----------------------------------------------------------------------------
+
+simple_bus_status simple_bus_crossbar::burst_read(unsigned int unique_priority
+						  , int *data
+						  , unsigned int start_address
+						  , unsigned int length
+						  , bool lock)
+{
+  if (sb_logging && m_verbose) 
+    sb_fprintf(stdout, "%s %s : burst_read(%d) @ %x\n",
+	       sc_time_stamp().to_string().c_str(), name(), unique_priority, 
+	       start_address);
+
+  simple_bus_request *request = get_request(unique_priority);
+  post_request(request, false, data, start_address,
+	       start_address + (length-1)*4, SIMPLE_BUS_WORD_ENABLE, lock);
+
+  wait(request->transfer_done);
+  wait(clock->posedge_event());
+  return request->status;
+}
+
+simple_bus_status simple_bus_crossbar::burst_write(unsigned int unique_priority
+						   , int *data
+						   , unsigned int start_address
+						   , unsigned int length
+						   , bool lock)
+{
+  if (sb_logging && m_verbose) 
+    sb_fprintf(stdout, "%s %s : burst_write(%d) @ %x\n",
+	       sc_time_stamp().to_string().c_str(), name(), unique_priority, 
+	       start_address);
+
+  simple_bus_request *request = get_request(unique_priority);
+  post_request(request, true, data, start_address,
+	       start_address + (length-1)*4, SIMPLE_BUS_WORD_ENABLE, lock);
+
+  wait(request->transfer_done);
+  wait(clock->posedge_event());
+  return request->status;
+}
+
+//----------------------------------------------------------------------------
+//-- loosely-timed BUS interface
+//----------------------------------------------------------------------------
+
+simple_bus_status simple_bus_crossbar::b_transport(bool do_write
+						   , int *data
+						   , unsigned int start_address
+						   , unsigned int length
+						   , sc_time &delay)
+{
+  if (sb_logging && m_verbose) 
+    sb_fprintf(stdout, "%s %s : b_transport(%s) @ %x\n",
+	       sc_time_stamp().to_string().c_str(), name(),
+	       do_write ? "write" : "read", start_address);
+
+  if (start_address%4 != 0 ) {// address not word alligned
+    sb_fprintf(stdout, "  BUS ERROR --> address %04X not word alligned\n",start_address);
+    return SIMPLE_BUS_ERROR;
+  }
+
+  // the data moves through the direct interface of the slave, the
+  // timing is what the word costs on its layer: one cycle to issue it,
+  // plus the wait states of the slave
+  for (unsigned int i = 0; i < length; ++i)
+    {
+      unsigned int address = start_address + 4*i;
+      simple_bus_crossbar_layer *layer = get_layer(address);
+      if (!layer) {
+	sb_fprintf(stdout, "  BUS ERROR --> no slave for address %04X \n",address);
+	return SIMPLE_BUS_ERROR;
+      }
+      simple_bus_slave_if *slave = layer->slave->slave;
+      bool ok = do_write ? slave->direct_write(data + i, address)
+			 : slave->direct_read(data + i, address);
+      if (!ok)
+	return SIMPLE_BUS_ERROR;
+      delay += m_clock_period * (double)(1 + layer->slave->nr_wait_states);
+      layer->words++;
+
+      if (sb_metrics) {
+	m_metrics.bytes_transferred.add(4);
+	m_metrics.transactions.add(1);
+	if (do_write)
+	  m_metrics.write_transactions.add(1);
+	else
+	  m_metrics.read_transactions.add(1);
+      }
+    }
+  return SIMPLE_BUS_OK;
+}
+
+//----------------------------------------------------------------------------
+//-- BUS methods:
+//
+//     post_request()     : fills in the request form of a master
+//     handle_request()   : performs atomic layer-to-slave request
+//     get_request()      : BUS-interface: gets the request form of given 
+//                          priority
+//     get_layer()        : decodes an address to the layer of its slave
+//     set_status()       : updates the status of a request and the mask
+//                          of pending request slots, and tells the
+//                          arbiters
+//     record_latency()   : books the latency of a completed request in
+//                          the histograms
+//     clear_locks()      : downgrade the lock status of the requests of
+//                          the layers that are free
+//----------------------------------------------------------------------------
+
+void simple_bus_crossbar::post_request(simple_bus_request *request
+				       , bool do_write
+				       , int *data
+				       , unsigned int start_address
+				       , unsigned int end_address
+				       , unsigned int byte_enable
+				       , bool lock)
+{
+  request->do_write           = do_write;
+  request->address            = start_address;
+  request->start_address      = start_address;
+  request->end_address        = end_address;
+  request->data               = data;
+  request->byte_enable        = byte_enable;
+  request->post_time          = sc_time_stamp();
+
+  if (lock)
+    request->lock = (request->lock == SIMPLE_BUS_LOCK_SET) ? 
+      SIMPLE_BUS_LOCK_GRANTED : SIMPLE_BUS_LOCK_SET;
+
+  set_status(request, SIMPLE_BUS_REQUEST);
+}
+
+void simple_bus_crossbar::handle_request(simple_bus_crossbar_layer &layer)
+{
+  simple_bus_request *request = layer.current;
+  if (sb_logging && m_verbose)
+    sb_fprintf(stdout, "%s %s Handle Slave(%d) on layer %u\n",
+	       sc_time_stamp().to_string().c_str(), name(), 
+	       request->priority, layer.slave->port_index);
+
+  set_status(request, SIMPLE_BUS_WAIT);
+  simple_bus_slave_if *slave = layer.slave->slave;
+
+  simple_bus_status slave_status = SIMPLE_BUS_OK;
+  if (request->do_write && (request->byte_enable != SIMPLE_BUS_WORD_ENABLE))
+    slave_status = slave->write_beat(request->data, request->address, 1,
+				     request->byte_enable);
+  else if (request->do_write)
+    slave_status = slave->write(request->data, request->address);
+  else
+    slave_status = slave->read(request->data, request->address);
+
+  if (sb_logging && m_verbose)
+    sb_fprintf(stdout, "  --> status=(%s)\n", simple_bus_status_str[slave_status]);
+
+  switch(slave_status)
+    {
+    case SIMPLE_BUS_ERROR:
+      set_status(request, SIMPLE_BUS_ERROR);
+      request->transfer_done.notify();
+      layer.current = (simple_bus_request *)0;
+      break;
+    case SIMPLE_BUS_OK:
+      request->address+=4; //next word (byte addressing)
+      request->data++;
+      layer.words++;
+      if (sb_metrics) {
+	m_metrics.bytes_transferred.add(4);
+	m_metrics.transactions.add(1);
+	if (request->do_write)
+	  m_metrics.write_transactions.add(1);
+	else
+	  m_metrics.read_transactions.add(1);
+      }
+      if (request->address > request->end_address)
+	{
+	  // burst-transfer (or single transfer) completed
+	  if (sb_metrics)
+	    record_latency(request, layer.slave);
+	  set_status(request, SIMPLE_BUS_OK);
+	  request->transfer_done.notify();
+	}
+      // more data may follow, but the (atomic) slave transfer is done
+      layer.current = (simple_bus_request *)0;
+      break;
+    case SIMPLE_BUS_WAIT:
+      // the slave is still processing: no clearance of the current request
+      break;
+    default:
+      break;
+    }
+}
+
+simple_bus_request * simple_bus_crossbar::get_request(unsigned int priority)
+{
+  simple_bus_request *found = m_request_index.find(priority);
+  if (found)
+    return found;
+
+  simple_bus_request *request = new simple_bus_request;
+  request->priority = priority;
+  request->slot = m_requests.size();
+  m_requests.push_back(request);
+  if (m_requests.size() > m_pending_mask.size()*64)
+    m_pending_mask.push_back(0ULL);
+  m_request_index.insert(request);
+  return request;
+}
+
+void simple_bus_crossbar::set_status(simple_bus_request *request
+				     , simple_bus_status status)
+{
+  // keep the pending-slot mask in step with the request status
+  unsigned long long bit = 1ULL << (request->slot % 64);
+  bool pending = (status == SIMPLE_BUS_REQUEST) || (status == SIMPLE_BUS_WAIT);
+  if (pending)
+    m_pending_mask[request->slot / 64] |= bit;
+  else
+    m_pending_mask[request->slot / 64] &= ~bit;
+  request->status = status;
+  for (int i = 0; i < arbiter_port.size(); ++i)
+    arbiter_port[i]->update(request, pending);
+}
+
+bool simple_bus_crossbar::is_pending(const simple_bus_request *request) const
+{
+  return (m_pending_mask[request->slot / 64] >> (request->slot % 64)) & 1ULL;
+}
+
+void simple_bus_crossbar::record_latency(simple_bus_request *request
+					 , simple_bus_decode_entry *slave)
+{
+  // from posting the request to transfer_done
+  uint64_t latency_ps = sb_time_ps(sc_time_stamp() - request->post_time);
+  if (request->do_write) {
+    m_metrics.write_time.add(latency_ps);
+    m_metrics.write_latency.record(latency_ps);
+  } else {
+    m_metrics.read_time.add(latency_ps);
+    m_metrics.read_latency.record(latency_ps);
+  }
+  m_metrics.master_latency[request->priority].record(latency_ps);
+  m_metrics.slave_latency[slave->port_index].record(latency_ps);
+}
+
+simple_bus_crossbar_layer * simple_bus_crossbar::get_layer(unsigned int address)
+{
+  simple_bus_decode_entry *entry = simple_bus_find_decode_entry(m_decode_table, address);
+  if (!entry)
+    return (simple_bus_crossbar_layer *)0;
+  return &m_layers[entry - &m_decode_table[0]];
+}
+
+void simple_bus_crossbar::clear_locks()
+{
+  // a layer that is free downgrades the locks of the requests aimed at
+  // it, just like simple_bus does for all requests when it is free
+  for (unsigned int i = 0; i < m_requests.size(); ++i)
+    {
+      simple_bus_request *request = m_requests[i];
+      simple_bus_crossbar_layer *layer = get_layer(request->address);
+      if (layer && layer->current)
+	continue;
+      simple_bus_lock_status lock = request->lock;
+      if (lock == SIMPLE_BUS_LOCK_GRANTED)
+	request->lock = SIMPLE_BUS_LOCK_SET;
+      else
+	request->lock = SIMPLE_BUS_LOCK_NO;
+      if (request->lock != lock)
+	for (int j = 0; j < arbiter_port.size(); ++j)
+	  arbiter_port[j]->update(request, is_pending(request));
+    }
+}
+
+void simple_bus_crossbar::report_bus_utilization()
+{
+  double simulation_time_sec = sc_time_stamp().to_seconds();
+  if ((m_cycles == 0) || (simulation_time_sec <= 0.0)) {
+    sb_fprintf(stdout, "ERROR: El tiempo total de simulación es 0. La simulación no avanzó.\n");
+    return;
+  }
+
+  unsigned long total_words = 0;
+  sb_fprintf(stdout, "====================================\n");
+  sb_fprintf(stdout, " Utilización del crossbar %s\n", name());
+  for (unsigned int i = 0; i < m_layers.size(); ++i)
+    {
+      const simple_bus_crossbar_layer &layer = m_layers[i];
+      sb_fprintf(stdout, "  Capa %u (%0X..%0X): %.2f%%, %lu palabras\n",
+		 layer.slave->port_index,
+		 layer.slave->start_address, layer.slave->end_address,
+		 100.0 * layer.active_cycles / m_cycles, layer.words);
+      total_words += layer.words;
+    }
+  sb_fprintf(stdout, "Bytes transferidos: %lu bytes\n", total_words * 4);
+  sb_fprintf(stdout, "Throughput agregado: %.2f bytes/segundo\n",
+	     total_words * 4 / simulation_time_sec);
+  if (sb_metrics) {
+    // comparable with the report of simple_bus on the same platform
+    double active_time_sec = m_metrics.active_time.get() * 1e-12;
+    sb_fprintf(stdout, "Nivel de utilización (alguna capa activa): %.2f%%\n",
+	       100.0 * active_time_sec / simulation_time_sec);
+    sb_fprintf(stdout, "Transacciones completadas: %llu (Lecturas: %llu, Escrituras: %llu)\n",
+	       (unsigned long long)m_metrics.transactions.get(),
+	       (unsigned long long)m_metrics.read_transactions.get(),
+	       (unsigned long long)m_metrics.write_transactions.get());
+    sb_fprintf(stdout, "Arbitrajes: %llu, peticiones no seleccionadas: %llu\n",
+	       (unsigned long long)m_metrics.arbitrations.get(),
+	       (unsigned long long)m_metrics.arbitration_rejections.get());
+  }
+  sb_fprintf(stdout, "====================================\n");
+}
+
+const simple_bus_metrics &simple_bus_crossbar::metrics() const
+{
+  return m_metrics;
+}
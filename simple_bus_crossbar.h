@@ -0,0 +1,210 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_crossbar.h : The multi-layer bus (crossbar).
+
+		 Same master interfaces as simple_bus, but every slave
+		 has its own layer with its own arbiter and its own
+		 current request. Transfers to different slaves proceed
+		 in the same clock cycle; only masters that target the
+		 same slave compete for it. The layers are 32 bits
+		 wide; write_bytes uses the byte strobes of the slave.
+
+		 The crossbar is derived from the following interfaces,
+		 and contains the implementation of these:
+		 - blocking : burst_read/burst_write
+		 - non-blocking : read/write/write_bytes/get_status
+		 - direct : direct_read/direct_write, with DMI; slave
+		   invalidations are passed on to the masters
+		 - loosely-timed : b_transport, one clock period per
+		   word plus the wait states of the slave
+
+		 Pending requests are kept in a slot mask, as in
+		 simple_bus, and the arbiters are told about every
+		 change. The crossbar owns a simple_bus_metrics object
+		 under its module name, so the metrics file, the sampler
+		 and the end-of-simulation report show the aggregate
+		 bandwidth of the layers next to the one of simple_bus.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#ifndef __simple_bus_crossbar_h
+#define __simple_bus_crossbar_h
+
+#include <systemc.h>
+#include <vector>
+
+#include "simple_bus_types.h"
+#include "simple_bus_request.h"
+#include "simple_bus_direct_if.h"
+#include "simple_bus_non_blocking_if.h"
+#include "simple_bus_blocking_if.h"
+#include "simple_bus_lt_if.h"
+#include "simple_bus_arbiter_if.h"
+#include "simple_bus_slave_if.h"
+#include "simple_bus_decoder.h"
+#include "simple_bus_metrics.h"
+
+// one layer of the crossbar: the path to a single slave
+struct simple_bus_crossbar_layer
+{
+  simple_bus_decode_entry *slave;
+  simple_bus_arbiter_if *arbiter;
+  simple_bus_request *current;
+  simple_bus_request_vec queue; // candidates of this cycle
+
+  // metrics
+  unsigned long active_cycles;
+  unsigned long words;
+};
+
+class simple_bus_crossbar
+  : public simple_bus_direct_if
+  , public simple_bus_non_blocking_if
+  , public simple_bus_blocking_if
+  , public simple_bus_lt_if
+  , public simple_bus_dmi_invalidate_if
+  , public sc_module
+{
+public:
+  // ports
+  sc_in_clk clock;
+  // either one arbiter for all layers, or one per slave (same order
+  // as the slaves are bound to slave_port)
+  sc_port<simple_bus_arbiter_if, 0> arbiter_port;
+  sc_port<simple_bus_slave_if, 0> slave_port;
+
+  // constructor
+  simple_bus_crossbar(sc_module_name name_
+		      , bool verbose = false)
+    : sc_module(name_)
+    , m_verbose(verbose)
+    , m_cycles(0)
+    , m_metrics(name())
+  {
+    // process declaration
+    SC_METHOD(main_action);
+    dont_initialize();
+    sensitive << clock.neg();
+  }
+
+  // process
+  void main_action();
+
+  void end_of_elaboration();
+  void end_of_simulation();
+
+  // direct BUS interface
+  bool direct_read(int *data, unsigned int address);
+  bool direct_write(int *data, unsigned int address);
+  bool get_direct_mem_ptr(unsigned int address, simple_bus_dmi &dmi);
+  void register_dmi_listener(simple_bus_dmi_invalidate_if *listener);
+
+  // DMI invalidation coming from a slave: passed on to the masters
+  void invalidate_direct_mem_ptr(unsigned int start_address
+				 , unsigned int end_address);
+
+  // non-blocking BUS interface
+  void read(unsigned int unique_priority
+	    , int *data
+	    , unsigned int address
+	    , bool lock = false);
+  void write(unsigned int unique_priority
+	     , int *data
+	     , unsigned int address
+	     , bool lock = false);
+  void write_bytes(unsigned int unique_priority
+		   , int *data
+		   , unsigned int address
+		   , unsigned int byte_enable
+		   , bool lock = false);
+  simple_bus_status get_status(unsigned int unique_priority);
+
+  // blocking BUS interface
+  simple_bus_status burst_read(unsigned int unique_priority
+			       , int *data
+			       , unsigned int start_address
+			       , unsigned int length = 1
+			       , bool lock = false);
+  simple_bus_status burst_write(unsigned int unique_priority
+				, int *data
+				, unsigned int start_address
+				, unsigned int length = 1
+				, bool lock = false);
+
+  // loosely-timed BUS interface: bypasses arbitration
+  simple_bus_status b_transport(bool do_write
+				, int *data
+				, unsigned int start_address
+				, unsigned int length
+				, sc_time &delay);
+
+  // utilization of every layer and the aggregate throughput
+  void report_bus_utilization();
+
+  // métricas del crossbar, también en simple_bus_metrics_registry
+  const simple_bus_metrics &metrics() const;
+
+private:
+  void post_request(simple_bus_request *request
+		    , bool do_write
+		    , int *data
+		    , unsigned int start_address
+		    , unsigned int end_address
+		    , unsigned int byte_enable
+		    , bool lock);
+  void handle_request(simple_bus_crossbar_layer &layer);
+  void set_status(simple_bus_request *request, simple_bus_status status);
+  bool is_pending(const simple_bus_request *request) const;
+  void record_latency(simple_bus_request *request
+		      , simple_bus_decode_entry *slave);
+  simple_bus_request * get_request(unsigned int priority);
+  simple_bus_crossbar_layer * get_layer(unsigned int address);
+  void clear_locks();
+
+private:
+  bool m_verbose;
+  simple_bus_request_vec m_requests;
+  simple_bus_request_index m_request_index; // priority -> request form
+  // slots in SIMPLE_BUS_REQUEST/SIMPLE_BUS_WAIT state, 64 per word
+  std::vector<unsigned long long> m_pending_mask;
+  simple_bus_decode_table m_decode_table;
+  std::vector<simple_bus_crossbar_layer> m_layers; // same order as the table
+  simple_bus_dmi_listeners m_dmi_listeners;
+  unsigned long m_cycles;
+  sc_time m_clock_period;
+
+  // Métricas del crossbar (por instancia)
+  simple_bus_metrics m_metrics;
+
+}; // end class simple_bus_crossbar
+
+#endif
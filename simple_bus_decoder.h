@@ -0,0 +1,136 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_decoder.h : Address decoding of the slaves of a bus.
+
+		 The slave address ranges are read once at the end of
+		 elaboration and kept sorted on start address. Lookups
+		 are a binary search, the overlap check a single sweep.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#ifndef __simple_bus_decoder_h
+#define __simple_bus_decoder_h
+
+#include <systemc.h>
+#include <algorithm>
+#include <vector>
+
+#include "simple_bus_types.h"
+#include "simple_bus_slave_if.h"
+
+// one entry of the address-decode table, built at end_of_elaboration
+struct simple_bus_decode_entry
+{
+  unsigned int start_address;
+  unsigned int end_address;
+  unsigned int port_index;
+  simple_bus_slave_if *slave;
+  unsigned int data_words; // words per access of the slave
+  unsigned int nr_wait_states;
+
+  // split mode: transfers parked at the slave, and the maximum
+  unsigned int nr_outstanding;
+  unsigned int max_outstanding;
+};
+
+typedef std::vector<simple_bus_decode_entry> simple_bus_decode_table;
+
+// fills the table with the ranges of all slaves bound to the port,
+// sorted on start address
+inline void simple_bus_build_decode_table(simple_bus_decode_table &table
+					  , sc_port<simple_bus_slave_if, 0> &slave_port)
+{
+  table.clear();
+  table.reserve(slave_port.size());
+  for (int i = 0; i < slave_port.size(); ++i)
+    {
+      simple_bus_decode_entry entry;
+      entry.port_index = i;
+      entry.slave = slave_port[i];
+      entry.start_address = entry.slave->start_address();
+      entry.end_address = entry.slave->end_address();
+      entry.data_words = entry.slave->data_width() / 4;
+      entry.nr_wait_states = entry.slave->nr_wait_states();
+      sc_assert((entry.data_words > 0) &&
+		!(entry.data_words & (entry.data_words - 1)));
+      entry.nr_outstanding = 0;
+      entry.max_outstanding = 1;
+      table.push_back(entry);
+    }
+  std::sort(table.begin(), table.end(),
+	    [](const simple_bus_decode_entry &a, const simple_bus_decode_entry &b)
+	    { return a.start_address < b.start_address; });
+}
+
+// binary search for the slave holding address, 0 if there is none
+inline simple_bus_decode_entry *
+simple_bus_find_decode_entry(simple_bus_decode_table &table, unsigned int address)
+{
+  unsigned int lo = 0;
+  unsigned int hi = table.size();
+  while (lo < hi)
+    {
+      unsigned int mid = lo + (hi - lo) / 2;
+      if (table[mid].start_address <= address)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+  if ((lo == 0) || (address > table[lo - 1].end_address))
+    return (simple_bus_decode_entry *)0;
+  return &table[lo - 1];
+}
+
+// reports every pair of overlapping slaves and returns their number:
+// the table is sorted on start address, so a slave can only overlap
+// with the slaves that follow it and start before its end
+inline unsigned int simple_bus_check_overlaps(const simple_bus_decode_table &table)
+{
+  unsigned int nr_overlaps = 0;
+  for (unsigned int i = 0; i < table.size(); ++i) {
+    const simple_bus_decode_entry &slave1 = table[i];
+    for (unsigned int j = i + 1; (j < table.size()) &&
+	   (table[j].start_address <= slave1.end_address); ++j) {
+      const simple_bus_decode_entry &slave2 = table[j];
+      if (nr_overlaps++ == 0)
+	sb_fprintf(stdout,"Error: overlapping address spaces of slaves : \n");
+      sb_fprintf(stdout,"slave %u : %0X..%0X overlaps slave %u : %0X..%0X\n",
+		 slave1.port_index, slave1.start_address, slave1.end_address,
+		 slave2.port_index, slave2.start_address, slave2.end_address);
+    }
+  }
+  if (nr_overlaps > 0)
+    sb_fprintf(stdout,"%u overlapping slave pair(s) found\n", nr_overlaps);
+  return nr_overlaps;
+}
+
+#endif
@@ -39,6 +39,45 @@
 #define __simple_bus_direct_if_h
 
 #include <systemc.h>
+#include <vector>
+
+// direct memory access to a slave region: ptr points to the word at
+// start_address, the region is contiguous up to end_address. The
+// memories hand out the run of their sparse backing store around the
+// address that is contiguous in host memory: the whole image of a
+// mapped memory, otherwise as little as one 4 KiB page (see
+// simple_bus_backing_store.h), so a copy past end_address must ask
+// for the next region
+struct simple_bus_dmi
+{
+  int *ptr;
+  unsigned int start_address;
+  unsigned int end_address;
+  bool read_allowed;
+  bool write_allowed;
+
+  simple_bus_dmi()
+    : ptr((int *)0)
+    , start_address(0)
+    , end_address(0)
+    , read_allowed(false)
+    , write_allowed(false)
+  {}
+
+  bool contains(unsigned int address) const
+  { return ptr && (start_address <= address) && (address <= end_address); }
+};
+
+// callback for holders of a simple_bus_dmi: the slave revoked access
+// to [start_address, end_address], pointers into it must be dropped
+class simple_bus_dmi_invalidate_if
+{
+public:
+  virtual void invalidate_direct_mem_ptr(unsigned int start_address
+					 , unsigned int end_address) = 0;
+  virtual ~simple_bus_dmi_invalidate_if() {}
+
+}; // end class simple_bus_dmi_invalidate_if
 
 class simple_bus_direct_if
   : public virtual sc_interface
@@ -48,6 +87,36 @@ public:
   virtual bool direct_read(int *data, unsigned int address) = 0;
   virtual bool direct_write(int *data, unsigned int address) = 0;
 
+  // direct memory interface: fills dmi with a raw pointer to the region
+  // around address. Returns false if no such pointer can be given.
+  virtual bool get_direct_mem_ptr(unsigned int address, simple_bus_dmi &dmi)
+  { return false; }
+  virtual void register_dmi_listener(simple_bus_dmi_invalidate_if *listener)
+  {}
+
 }; // end class simple_bus_direct_if
 
+// the registered DMI listeners of a bus or slave
+class simple_bus_dmi_listeners
+{
+public:
+  void add(simple_bus_dmi_invalidate_if *listener)
+  {
+    for (unsigned int i = 0; i < m_listeners.size(); ++i)
+      if (m_listeners[i] == listener)
+	return;
+    m_listeners.push_back(listener);
+  }
+
+  void invalidate(unsigned int start_address, unsigned int end_address)
+  {
+    for (unsigned int i = 0; i < m_listeners.size(); ++i)
+      m_listeners[i]->invalidate_direct_mem_ptr(start_address, end_address);
+  }
+
+private:
+  std::vector<simple_bus_dmi_invalidate_if *> m_listeners;
+
+}; // end class simple_bus_dmi_listeners
+
 #endif
@@ -0,0 +1,261 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_dram.cpp : A memory with DRAM bank and row-buffer timing.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#include "simple_bus_dram.h"
+
+simple_bus_dram::simple_bus_dram(sc_module_name name_
+				 , unsigned int start_address
+				 , unsigned int end_address
+				 , unsigned int nr_banks
+				 , unsigned int row_size
+				 , unsigned int trcd
+				 , unsigned int tcas
+				 , unsigned int trp
+				 , unsigned int window
+				 , const sc_time &clock_period
+				 , unsigned int data_width)
+  : simple_bus_memory(start_address, end_address, data_width)
+  , sc_module(name_)
+  , m_row_size(row_size)
+  , m_trcd(trcd)
+  , m_tcas(tcas)
+  , m_trp(trp)
+  , m_window(window)
+  , m_clock_period(clock_period)
+  , m_reordered(0)
+{
+  // a beat stays within one row
+  sc_assert((m_row_size >= m_data_width) && (m_row_size % m_data_width == 0));
+  sc_assert((nr_banks > 0) && (m_window > 0));
+
+  dram_bank bank = { false, 0, SC_ZERO_TIME, 0, 0, 0 };
+  m_banks.assign(nr_banks, bank);
+  m_queue.reserve(m_window);
+}
+
+void simple_bus_dram::end_of_simulation()
+{
+  report_dram_statistics();
+}
+
+//----------------------------------------------------------------------------
+//-- timing
+//----------------------------------------------------------------------------
+
+// the bus calls on every falling edge until the access is done, like
+// simple_bus_slow_mem_clockless; a new access waits outside the queue
+// while all window entries are taken. The bus keeps at most one
+// transfer per address outstanding, so the address finds the entry.
+simple_bus_status simple_bus_dram::access(unsigned int address, bool do_write)
+{
+  const sc_time &now = sc_time_stamp();
+  unsigned int index = 0;
+  while ((index < m_queue.size()) && (m_queue[index].address != address))
+    ++index;
+  sc_assert((index == m_queue.size()) || (m_queue[index].do_write == do_write));
+  if (index == m_queue.size())
+    {
+      if (m_queue.size() >= m_window)
+	return SIMPLE_BUS_WAIT;
+      unsigned int line = (address - m_start_address) / m_row_size;
+      dram_access entry;
+      entry.address = address;
+      entry.do_write = do_write;
+      entry.bank = line % m_banks.size();
+      entry.row = line / m_banks.size();
+      entry.scheduled = false;
+      entry.ready_time = SC_ZERO_TIME;
+      m_queue.push_back(entry);
+    }
+
+  schedule(now);
+  const dram_access &entry = m_queue[index];
+  if (!entry.scheduled || (now < entry.ready_time))
+    return SIMPLE_BUS_WAIT;
+  m_queue.erase(m_queue.begin() + index);
+  return SIMPLE_BUS_OK;
+}
+
+// FR-FCFS: every free bank starts its oldest access to the open row,
+// or else its oldest access
+void simple_bus_dram::schedule(const sc_time &now)
+{
+  for (unsigned int bank = 0; bank < m_banks.size(); ++bank)
+    {
+      const dram_bank &state = m_banks[bank];
+      if (state.busy_until > now)
+	continue;
+      int choice = -1;
+      for (unsigned int i = 0; i < m_queue.size(); ++i)
+	{
+	  const dram_access &entry = m_queue[i];
+	  if (entry.scheduled || (entry.bank != bank))
+	    continue;
+	  if (choice < 0)
+	    choice = i;
+	  if (state.open && (entry.row == state.row))
+	    {
+	      choice = i;
+	      break;
+	    }
+	}
+      if (choice >= 0)
+	start(choice, now);
+    }
+}
+
+void simple_bus_dram::start(unsigned int index, const sc_time &now)
+{
+  dram_access &entry = m_queue[index];
+  dram_bank &bank = m_banks[entry.bank];
+  unsigned int wait_states = m_tcas;
+  bool row_hit = bank.open && (bank.row == entry.row);
+  if (!bank.open)
+    wait_states += m_trcd;
+  else if (!row_hit)
+    wait_states += m_trp + m_trcd;
+
+  if (sb_metrics)
+    {
+      bank.accesses++;
+      if (row_hit)
+	bank.row_hits++;
+      else if (bank.open)
+	bank.row_conflicts++;
+      for (unsigned int i = 0; i < index; ++i)
+	if (!m_queue[i].scheduled)
+	  {
+	    m_reordered++;
+	    break;
+	  }
+    }
+
+  bank.open = true;
+  bank.row = entry.row;
+  entry.scheduled = true;
+  entry.ready_time = now + m_clock_period * (double)wait_states;
+  bank.busy_until = entry.ready_time;
+}
+
+//----------------------------------------------------------------------------
+//-- checkpoints
+//----------------------------------------------------------------------------
+
+bool simple_bus_dram::snapshot_ready() const
+{
+  return m_queue.empty();
+}
+
+// format: the contents (simple_bus_backing_store::save), uint32 number
+// of banks, per bank uint32 open row or ~0
+bool simple_bus_dram::save_state(FILE *file) const
+{
+  if (!simple_bus_memory::save_state(file))
+    return false;
+  uint32_t nr_banks = m_banks.size();
+  if (fwrite(&nr_banks, sizeof(nr_banks), 1, file) != 1)
+    return false;
+  for (unsigned int i = 0; i < m_banks.size(); ++i)
+    {
+      uint32_t row = m_banks[i].open ? m_banks[i].row : ~0u;
+      if (fwrite(&row, sizeof(row), 1, file) != 1)
+	return false;
+    }
+  return true;
+}
+
+bool simple_bus_dram::restore_state(FILE *file)
+{
+  uint32_t nr_banks;
+  if (!simple_bus_memory::restore_state(file) ||
+      (fread(&nr_banks, sizeof(nr_banks), 1, file) != 1) ||
+      (nr_banks != m_banks.size()))
+    return false;
+  for (unsigned int i = 0; i < m_banks.size(); ++i)
+    {
+      uint32_t row;
+      if (fread(&row, sizeof(row), 1, file) != 1)
+	return false;
+      m_banks[i].open = (row != ~0u);
+      m_banks[i].row = m_banks[i].open ? row : 0;
+      m_banks[i].busy_until = SC_ZERO_TIME;
+    }
+  m_queue.clear();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+//-- report
+//----------------------------------------------------------------------------
+
+void simple_bus_dram::report_dram_statistics()
+{
+  if (!sb_metrics) {
+    sb_fprintf(stdout, "Estadísticas de DRAM desactivadas en esta compilación (SIMPLE_BUS_NO_METRICS)\n");
+    return;
+  }
+
+  uint64_t accesses = 0, row_hits = 0, row_conflicts = 0;
+  for (unsigned int i = 0; i < m_banks.size(); ++i)
+    {
+      accesses += m_banks[i].accesses;
+      row_hits += m_banks[i].row_hits;
+      row_conflicts += m_banks[i].row_conflicts;
+    }
+
+  sb_fprintf(stdout, "\n--- Estadísticas de DRAM %s ---\n", name());
+  sb_fprintf(stdout, "Bancos: %u, filas de %u bytes, tRCD %u, tCAS %u, tRP %u, ventana %u\n",
+	     (unsigned int)m_banks.size(), m_row_size, m_trcd, m_tcas, m_trp, m_window);
+  if (accesses == 0) {
+    sb_fprintf(stdout, "No se realizaron accesos a la DRAM\n");
+    return;
+  }
+  sb_fprintf(stdout, "Accesos: %llu, aciertos de fila: %llu (%.2f%%), filas cerradas: %llu, conflictos de fila: %llu\n",
+	     (unsigned long long)accesses, (unsigned long long)row_hits,
+	     100.0 * row_hits / accesses,
+	     (unsigned long long)(accesses - row_hits - row_conflicts),
+	     (unsigned long long)row_conflicts);
+  sb_fprintf(stdout, "Accesos reordenados (FR-FCFS): %llu\n", (unsigned long long)m_reordered);
+  for (unsigned int i = 0; i < m_banks.size(); ++i)
+    {
+      const dram_bank &bank = m_banks[i];
+      if (bank.accesses == 0)
+	continue;
+      sb_fprintf(stdout, "  banco %u: accesos %llu, aciertos de fila %.2f%%, conflictos %llu\n",
+		 i, (unsigned long long)bank.accesses,
+		 100.0 * bank.row_hits / bank.accesses,
+		 (unsigned long long)bank.row_conflicts);
+    }
+}
@@ -0,0 +1,224 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_dram.h : A memory with DRAM bank and row-buffer timing.
+
+		 The memory has nr_banks banks; consecutive rows of
+		 row_size bytes go to consecutive banks. Every bank keeps
+		 its last row open: an access to the open row takes tCAS
+		 wait states, one to a bank without an open row
+		 tRCD + tCAS, and one to another row tRP + tRCD + tCAS.
+		 Banks work in parallel.
+
+		 Accesses wait in a queue of window entries. When a bank
+		 is free, the oldest access to its open row goes first,
+		 otherwise the oldest access to the bank (FR-FCFS). The
+		 bus issues more than one access at a time only in split
+		 mode with an outstanding depth of window for this slave;
+		 with a window of 1 accesses are served in order. An entry
+		 is known by its address: the bus never parks two
+		 transfers to the same address, so accesses to one word
+		 keep their order.
+
+		 The direct interface and direct memory access bypass the
+		 timing; nr_wait_states() is the open-row latency (tCAS).
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#ifndef __simple_bus_dram_h
+#define __simple_bus_dram_h
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+#include <systemc.h>
+
+#include "simple_bus_types.h"
+#include "simple_bus_memory.h"
+
+
+class simple_bus_dram
+  : public simple_bus_memory
+  , public sc_module
+{
+public:
+  // constructor
+  simple_bus_dram(sc_module_name name_
+		  , unsigned int start_address
+		  , unsigned int end_address
+		  , unsigned int nr_banks
+		  , unsigned int row_size
+		  , unsigned int trcd
+		  , unsigned int tcas
+		  , unsigned int trp
+		  , unsigned int window
+		  , const sc_time &clock_period
+		  , unsigned int data_width = 4);
+
+  // SystemC callbacks
+  void end_of_simulation();
+
+  // direct Slave Interface
+  bool direct_read(int *data, unsigned int address);
+  bool direct_write(int *data, unsigned int address);
+
+  // Slave Interface
+  simple_bus_status read(int *data, unsigned int address);
+  simple_bus_status write(int *data, unsigned int address);
+  unsigned int data_width() const;
+  simple_bus_status read_beat(int *data, unsigned int address
+			      , unsigned int words);
+  simple_bus_status write_beat(int *data, unsigned int address
+			       , unsigned int words, unsigned int byte_enable);
+  unsigned int nr_wait_states() const;
+
+  unsigned int start_address() const;
+  unsigned int end_address() const;
+
+  // checkpoints: the contents and the open rows; only with an empty
+  // queue
+  bool snapshot_ready() const;
+  bool save_state(FILE *file) const;
+  bool restore_state(FILE *file);
+
+  // row-buffer hit rate, per bank, and the reordered accesses
+  void report_dram_statistics();
+
+private:
+  struct dram_bank
+  {
+    bool open;
+    unsigned int row;      // the open row
+    sc_time busy_until;
+    uint64_t accesses;
+    uint64_t row_hits;
+    uint64_t row_conflicts;
+  };
+
+  struct dram_access
+  {
+    unsigned int address;
+    bool do_write;
+    unsigned int bank;
+    unsigned int row;
+    bool scheduled;
+    sc_time ready_time;
+  };
+
+  simple_bus_status access(unsigned int address, bool do_write);
+  void schedule(const sc_time &now);
+  void start(unsigned int index, const sc_time &now);
+
+  unsigned int m_row_size;
+  unsigned int m_trcd;
+  unsigned int m_tcas;
+  unsigned int m_trp;
+  unsigned int m_window;
+  sc_time m_clock_period;
+
+  std::vector<dram_bank> m_banks;
+  std::vector<dram_access> m_queue; // in arrival order
+  uint64_t m_reordered;
+
+}; // end class simple_bus_dram
+
+inline bool simple_bus_dram::direct_read(int *data, unsigned int address)
+{
+  *data = MEM.read(address - m_start_address);
+  return true;
+}
+
+inline bool simple_bus_dram::direct_write(int *data, unsigned int address)
+{
+  MEM.write(address - m_start_address, *data);
+  return true;
+}
+
+inline simple_bus_status simple_bus_dram::read(int *data, unsigned int address)
+{
+  simple_bus_status status = access(address, false);
+  if (status == SIMPLE_BUS_OK)
+    *data = MEM.read(address - m_start_address);
+  return status;
+}
+
+inline simple_bus_status simple_bus_dram::write(int *data, unsigned int address)
+{
+  simple_bus_status status = access(address, true);
+  if (status == SIMPLE_BUS_OK)
+    MEM.write(address - m_start_address, *data);
+  return status;
+}
+
+inline unsigned int simple_bus_dram::data_width() const
+{
+  return m_data_width;
+}
+
+inline simple_bus_status simple_bus_dram::read_beat(int *data
+						    , unsigned int address
+						    , unsigned int words)
+{
+  sc_assert(words*4 <= m_data_width);
+  simple_bus_status status = access(address, false);
+  if (status == SIMPLE_BUS_OK)
+    MEM.read(data, address - m_start_address, words);
+  return status;
+}
+
+inline simple_bus_status simple_bus_dram::write_beat(int *data
+						     , unsigned int address
+						     , unsigned int words
+						     , unsigned int byte_enable)
+{
+  sc_assert(words*4 <= m_data_width);
+  simple_bus_status status = access(address, true);
+  if (status == SIMPLE_BUS_OK)
+    MEM.write_lanes(data, address - m_start_address, words, byte_enable);
+  return status;
+}
+
+inline unsigned int simple_bus_dram::nr_wait_states() const
+{
+  return m_tcas;
+}
+
+inline unsigned int simple_bus_dram::start_address() const
+{
+  return m_start_address;
+}
+
+inline unsigned int simple_bus_dram::end_address() const
+{
+  return m_end_address;
+}
+
+#endif
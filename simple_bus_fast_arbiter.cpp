@@ -0,0 +1,291 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_fast_arbiter.cpp : The arbitration unit, bit-set implementation.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#include <algorithm>
+
+#include "simple_bus_arbiter.h"
+#include "simple_bus_fast_arbiter.h"
+
+// position of the lowest set bit in a bit set, or -1 if it is empty
+static int first_bit(const std::vector<unsigned long long> &bits)
+{
+  for (unsigned int w = 0; w < bits.size(); ++w)
+    if (bits[w])
+      return w*64 + sb_lowest_bit(bits[w]);
+  return -1;
+}
+
+static bool test_bit(const std::vector<unsigned long long> &bits
+		     , unsigned int index)
+{
+  return (index / 64 < bits.size()) && ((bits[index / 64] >> (index % 64)) & 1ULL);
+}
+
+static void assign_bit(std::vector<unsigned long long> &bits
+		       , unsigned int index, bool value)
+{
+  if (value)
+    bits[index / 64] |= 1ULL << (index % 64);
+  else
+    bits[index / 64] &= ~(1ULL << (index % 64));
+}
+
+static void reset_bits(std::vector<unsigned long long> &bits
+		       , unsigned int nr_bits)
+{
+  unsigned int nr_words = (nr_bits + 63) / 64;
+  if (bits.size() < nr_words)
+    bits.resize(nr_words);
+  std::fill(bits.begin(), bits.end(), 0ULL);
+}
+
+simple_bus_request *
+simple_bus_fast_arbiter::arbitrate(const simple_bus_request_vec &requests)
+{
+  // Registrar tiempo de inicio del arbitraje
+  sc_time arbitration_start_time = sb_metrics ? sc_time_stamp() : SC_ZERO_TIME;
+
+  unsigned int i;
+
+  if (sb_logging && m_verbose) 
+    { // shows the list of pending requests
+      sb_fprintf(stdout, "%s %s :", sc_time_stamp().to_string().c_str(), name());
+      for (i = 0; i < requests.size(); ++i)
+	{
+	  simple_bus_request *request = requests[i];
+	  // simple_bus_lock_status encoding
+	  const char lock_chars[] = { '-', '=', '+' };
+	  // simple_bus_status encoding
+	  sb_fprintf(stdout, "\n    R[%d](%c%s@%x)",
+		     request->priority,
+		     lock_chars[request->lock],
+		     simple_bus_status_str[request->status],
+		     request->address);
+	}
+    }
+
+  // the candidates are a subset of the pending set: if the counts
+  // match, the sets kept by update() decide; rules 1 and 2 then pick
+  // the lowest slot, which is the first one in the queue of the bus
+  const std::vector<unsigned long long> *locked_burst = &m_locked_burst;
+  const std::vector<unsigned long long> *lock_granted = &m_lock_granted;
+  const std::vector<unsigned long long> *pending = &m_pending;
+  const simple_bus_request_vec *by_position = &m_by_slot;
+  if (requests.size() != m_nr_pending)
+    {
+      collect(requests);
+      locked_burst = &m_candidate_locked_burst;
+      lock_granted = &m_candidate_lock_granted;
+      pending = &m_candidates;
+      by_position = &requests;
+    }
+
+  // highest priority: status==SIMPLE_BUS_WAIT and lock is set: 
+  // locked burst-action
+  int winner = first_bit(*locked_burst);
+  if (winner >= 0)
+    {
+      simple_bus_request *request = (*by_position)[winner];
+      if (sb_logging && m_verbose)
+	sb_fprintf(stdout, " -> R[%d] (rule 1)\n", request->priority);
+      grant(request, requests.size(), arbitration_start_time);
+      return request;
+    }
+
+  // second priority: lock is set at previous call, 
+  // i.e. SIMPLE_BUS_LOCK_GRANTED
+  winner = first_bit(*lock_granted);
+  if (winner >= 0)
+    {
+      simple_bus_request *request = (*by_position)[winner];
+      if (sb_logging && m_verbose)
+	sb_fprintf(stdout, " -> R[%d] (rule 2)\n", request->priority);
+      grant(request, requests.size(), arbitration_start_time);
+      return request;
+    }
+
+  // third priority: priority
+  simple_bus_request *best_request = m_by_rank[first_bit(*pending)];
+
+  if (best_request->lock != SIMPLE_BUS_LOCK_NO)
+    {
+      best_request->lock = SIMPLE_BUS_LOCK_GRANTED;
+      update(best_request, test_bit(m_pending_slots, best_request->slot));
+    }
+
+  if (sb_logging && m_verbose) 
+    sb_fprintf(stdout, " -> R[%d] (rule 3)\n", best_request->priority);
+
+  grant(best_request, requests.size(), arbitration_start_time);
+  return best_request;
+}
+
+void simple_bus_fast_arbiter::update(simple_bus_request *request, bool pending)
+{
+  unsigned int slot = request->slot;
+  if ((slot >= m_by_slot.size()) || (m_by_slot[slot] != request))
+    add_request(request);
+
+  if (test_bit(m_pending_slots, slot) != pending)
+    {
+      assign_bit(m_pending_slots, slot, pending);
+      assign_bit(m_pending, m_rank[slot], pending);
+      if (pending)
+	m_nr_pending++;
+      else
+	m_nr_pending--;
+    }
+  assign_bit(m_locked_burst, slot, pending &&
+	     (request->status == SIMPLE_BUS_WAIT) &&
+	     (request->lock == SIMPLE_BUS_LOCK_SET));
+  assign_bit(m_lock_granted, slot, pending &&
+	     (request->lock == SIMPLE_BUS_LOCK_GRANTED));
+}
+
+void simple_bus_fast_arbiter::add_request(simple_bus_request *request)
+{
+  // a new master: once per request form, so the rank-indexed set is
+  // simply rebuilt
+  unsigned int slot = request->slot;
+  if (slot >= m_by_slot.size())
+    {
+      m_by_slot.resize(slot + 1, (simple_bus_request *)0);
+      m_rank.resize(slot + 1, 0);
+      master_grants.resize(slot + 1, 0);
+      unsigned int nr_words = (slot + 64) / 64;
+      m_pending_slots.resize(nr_words, 0ULL);
+      m_locked_burst.resize(nr_words, 0ULL);
+      m_lock_granted.resize(nr_words, 0ULL);
+    }
+  sc_assert(!m_by_slot[slot]);
+  m_by_slot[slot] = request;
+
+  simple_bus_request_vec::iterator position = m_by_rank.begin();
+  while ((position != m_by_rank.end()) &&
+	 ((*position)->priority < request->priority))
+    ++position;
+  sc_assert((position == m_by_rank.end()) ||
+	    ((*position)->priority != request->priority));
+  m_by_rank.insert(position, request);
+
+  reset_bits(m_pending, m_by_rank.size());
+  for (unsigned int rank = 0; rank < m_by_rank.size(); ++rank)
+    {
+      unsigned int other = m_by_rank[rank]->slot;
+      m_rank[other] = rank;
+      assign_bit(m_pending, rank, test_bit(m_pending_slots, other));
+    }
+}
+
+void simple_bus_fast_arbiter::collect(const simple_bus_request_vec &requests)
+{
+  // one pass over the candidates fills the three bit sets
+  reset_bits(m_candidate_locked_burst, requests.size());
+  reset_bits(m_candidate_lock_granted, requests.size());
+  unsigned int i;
+  for (i = 0; i < requests.size(); ++i)
+    {
+      simple_bus_request *request = requests[i];
+      unsigned int slot = request->slot;
+      if ((slot >= m_by_slot.size()) || (m_by_slot[slot] != request))
+	add_request(request);
+      if ((request->status == SIMPLE_BUS_WAIT) &&
+	  (request->lock == SIMPLE_BUS_LOCK_SET))
+	assign_bit(m_candidate_locked_burst, i, true);
+      if (request->lock == SIMPLE_BUS_LOCK_GRANTED)
+	assign_bit(m_candidate_lock_granted, i, true);
+    }
+  reset_bits(m_candidates, m_by_rank.size());
+  for (i = 0; i < requests.size(); ++i)
+    assign_bit(m_candidates, m_rank[requests[i]->slot], true);
+}
+
+void simple_bus_fast_arbiter::grant(const simple_bus_request *request
+				    , unsigned int nr_requests
+				    , const sc_time &arbitration_start_time)
+{
+  if (!sb_metrics)
+    return;
+
+  // Actualizar métricas de arbitraje
+  arbitration_decisions++;
+  master_grants[request->slot]++;
+  total_request_rejections += nr_requests - 1;
+  total_arbitration_wait_time += sc_time_stamp() - arbitration_start_time;
+}
+
+void simple_bus_fast_arbiter::report_arbitration_efficiency()
+{
+  if (!sb_metrics) {
+    sb_fprintf(stdout, "Métricas de arbitraje desactivadas en esta compilación (SIMPLE_BUS_NO_METRICS)\n");
+    return;
+  }
+
+  sb_fprintf(stdout, "\n--- Métricas de Eficiencia de Arbitraje ---\n");
+  sb_fprintf(stdout, "Política de arbitraje: %s\n", simple_bus_arbiter_policy_str[SIMPLE_BUS_ARB_PRIORITY]);
+
+  // Tiempo promedio de arbitraje
+  if (arbitration_decisions > 0) {
+    double avg_arbitration_time = total_arbitration_wait_time.to_seconds() / arbitration_decisions;
+    sb_fprintf(stdout, "Tiempo promedio de arbitraje: %.12f segundos\n", avg_arbitration_time);
+  } else {
+    sb_fprintf(stdout, "No se realizaron decisiones de arbitraje\n");
+  }
+
+  // Distribución de acceso
+  sb_fprintf(stdout, "Distribución de acceso por maestro:\n");
+  for (unsigned int rank = 0; rank < m_by_rank.size(); ++rank) {
+    const simple_bus_request *request = m_by_rank[rank];
+    unsigned int grants = master_grants[request->slot];
+    if (grants == 0)
+      continue;
+    double percentage = arbitration_decisions > 0 ? 
+                       (100.0 * grants / arbitration_decisions) : 0.0;
+    sb_fprintf(stdout, "  Maestro %u: %u accesos (%.2f%%)\n", 
+              request->priority, grants, percentage);
+  }
+
+  // Tasa de rechazo
+  if ((total_request_rejections + arbitration_decisions) > 0) {
+    double rejection_rate = 100.0 * total_request_rejections / 
+                           (total_request_rejections + arbitration_decisions);
+    sb_fprintf(stdout, "Tasa de rechazo de solicitudes: %.2f%%\n", rejection_rate);
+    sb_fprintf(stdout, "Total de solicitudes rechazadas: %u\n", total_request_rejections);
+  } else {
+    sb_fprintf(stdout, "No se registraron rechazos de solicitudes\n");
+  }
+
+  sb_fprintf(stdout, "Total de decisiones de arbitraje: %u\n", arbitration_decisions);
+}
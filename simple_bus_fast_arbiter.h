@@ -0,0 +1,116 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_fast_arbiter.h : The arbitration unit, bit-set implementation.
+
+		 Same three rules as simple_bus_arbiter (fixed priority
+		 only). The bus tells the arbiter through update() when a
+		 request form becomes pending or is retired, and when its
+		 lock changes, so the pending, locked-burst and granted-lock
+		 sets are always up to date; arbitrate picks the winner with
+		 count-trailing-zeros without looking at the candidates.
+		 When the bus holds some pending requests back (or its
+		 owner does not call update), the candidate list differs
+		 from the pending set and the sets are built from the
+		 candidates in one pass instead.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#ifndef __simple_bus_fast_arbiter_h
+#define __simple_bus_fast_arbiter_h
+
+#include <systemc.h>
+#include <vector>
+
+#include "simple_bus_types.h"
+#include "simple_bus_request.h"
+#include "simple_bus_arbiter_if.h"
+
+
+class simple_bus_fast_arbiter
+  : public simple_bus_arbiter_if
+  , public sc_module
+{
+public:
+  // constructor
+  simple_bus_fast_arbiter(sc_module_name name_
+			  , bool verbose = false)
+    : sc_module(name_)
+    , m_verbose(verbose)
+    , m_nr_pending(0)
+    , total_arbitration_wait_time(SC_ZERO_TIME)
+    , arbitration_decisions(0)
+    , total_request_rejections(0)
+  {}
+
+  simple_bus_request *arbitrate(const simple_bus_request_vec &requests);
+  void update(simple_bus_request *request, bool pending);
+
+  // Función para reportar métricas de eficiencia de arbitraje
+  void report_arbitration_efficiency();
+
+private:
+  void add_request(simple_bus_request *request);
+  void collect(const simple_bus_request_vec &requests);
+  void grant(const simple_bus_request *request
+	     , unsigned int nr_requests
+	     , const sc_time &arbitration_start_time);
+
+  bool m_verbose;
+
+  // the request forms known to the arbiter: by bus slot, and sorted on
+  // priority (rank); a form is added the first time it shows up
+  simple_bus_request_vec m_by_slot;
+  simple_bus_request_vec m_by_rank;
+  std::vector<unsigned int> m_rank; // slot -> rank
+
+  // pending request forms, kept up to date by update() (64 per word)
+  std::vector<unsigned long long> m_pending_slots; // by slot
+  std::vector<unsigned long long> m_pending;       // rule 3, by rank
+  std::vector<unsigned long long> m_locked_burst;  // rule 1, by slot
+  std::vector<unsigned long long> m_lock_granted;  // rule 2, by slot
+  unsigned int m_nr_pending;
+
+  // the same sets built from a candidate list (collect); rules 1 and 2
+  // by queue position
+  std::vector<unsigned long long> m_candidates;
+  std::vector<unsigned long long> m_candidate_locked_burst;
+  std::vector<unsigned long long> m_candidate_lock_granted;
+
+  // Variables para métricas de arbitraje
+  sc_time total_arbitration_wait_time;
+  unsigned int arbitration_decisions;
+  std::vector<unsigned int> master_grants; // indexed on slot
+  unsigned int total_request_rejections;
+
+}; // end class simple_bus_fast_arbiter
+
+#endif
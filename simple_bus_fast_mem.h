@@ -41,32 +41,22 @@
 #include <systemc.h>
 
 #include "simple_bus_types.h"
-#include "simple_bus_slave_if.h"
+#include "simple_bus_memory.h"
 
 
 class simple_bus_fast_mem
-  : public simple_bus_slave_if
+  : public simple_bus_memory
   , public sc_module
 {
 public:
   // constructor
   simple_bus_fast_mem(sc_module_name name_
 		      , unsigned int start_address
-		      , unsigned int end_address)
-    : sc_module(name_)
-    , m_start_address(start_address)
-    , m_end_address(end_address)
-  {
-    sc_assert(m_start_address <= m_end_address);
-    sc_assert((m_end_address-m_start_address+1)%4 == 0);
-    unsigned int size = (m_end_address-m_start_address+1)/4;
-    MEM = new int [size];
-    for (unsigned int i = 0; i < size; ++i)
-      MEM[i] = 0;
-  }
-
-  // destructor
-  ~simple_bus_fast_mem();
+		      , unsigned int end_address
+		      , unsigned int data_width = 4)
+    : simple_bus_memory(start_address, end_address, data_width)
+    , sc_module(name_)
+  {}
 
   // direct Slave Interface
   bool direct_read(int *data, unsigned int address);
@@ -75,15 +65,17 @@ public:
   // Slave Interface
   simple_bus_status read(int *data, unsigned int address);
   simple_bus_status write(int *data, unsigned int address);
+  bool burst_read(int *data, unsigned int address, unsigned int length);
+  bool burst_write(int *data, unsigned int address, unsigned int length);
+  unsigned int data_width() const;
+  simple_bus_status read_beat(int *data, unsigned int address
+			      , unsigned int words);
+  simple_bus_status write_beat(int *data, unsigned int address
+			       , unsigned int words, unsigned int byte_enable);
 
   unsigned int start_address() const;
   unsigned int end_address() const;
 
-private:
-  int * MEM;
-  unsigned int m_start_address;
-  unsigned int m_end_address;
-
 }; // end class simple_bus_fast_mem
 
 inline bool simple_bus_fast_mem::direct_read(int *data, unsigned int address)
@@ -99,21 +91,57 @@ inline bool simple_bus_fast_mem::direct_write(int *data, unsigned int address)
 inline simple_bus_status simple_bus_fast_mem::read(int *data
 						   , unsigned int address)
 {
-  *data = MEM[(address - m_start_address)/4];
+  *data = MEM.read(address - m_start_address);
   return SIMPLE_BUS_OK;
 }
 
 inline simple_bus_status simple_bus_fast_mem::write(int *data
 						    , unsigned int address)
 {
-  MEM[(address - m_start_address)/4] = *data;
+  MEM.write(address - m_start_address, *data);
   return SIMPLE_BUS_OK;
 }
 
-inline  simple_bus_fast_mem::~simple_bus_fast_mem()
+inline bool simple_bus_fast_mem::burst_read(int *data
+					    , unsigned int address
+					    , unsigned int length)
+{
+  sc_assert(address + (length-1)*4 <= m_end_address);
+  MEM.read(data, address - m_start_address, length);
+  return true;
+}
+
+inline bool simple_bus_fast_mem::burst_write(int *data
+					     , unsigned int address
+					     , unsigned int length)
 {
-  if (MEM) delete [] MEM;
-  MEM = (int *)0;
+  sc_assert(address + (length-1)*4 <= m_end_address);
+  MEM.write(data, address - m_start_address, length);
+  return true;
+}
+
+inline unsigned int simple_bus_fast_mem::data_width() const
+{
+  return m_data_width;
+}
+
+inline simple_bus_status simple_bus_fast_mem::read_beat(int *data
+							, unsigned int address
+							, unsigned int words)
+{
+  sc_assert(words*4 <= m_data_width);
+  MEM.read(data, address - m_start_address, words);
+  return SIMPLE_BUS_OK;
+}
+
+inline simple_bus_status simple_bus_fast_mem::write_beat(int *data
+							 , unsigned int address
+							 , unsigned int words
+							 , unsigned int byte_enable)
+{
+  sc_assert(words*4 <= m_data_width);
+  MEM.write_lanes(data, address - m_start_address, words, byte_enable);
+  return SIMPLE_BUS_OK;
 }
 
 inline unsigned int simple_bus_fast_mem::start_address() const
@@ -0,0 +1,149 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_histogram.h : Log-linear (HDR-style) histogram.
+
+		 Values below 2*S (S = 2^SIMPLE_BUS_HISTOGRAM_SUB_BITS)
+		 are counted exactly; above that every power of two is
+		 split into S equal buckets, so a bucket is never wider
+		 than 1/S of its value (3% for S = 32). The histogram
+		 grows with the largest value recorded, and recording
+		 is a shift and an increment.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#ifndef __simple_bus_histogram_h
+#define __simple_bus_histogram_h
+
+#include <stdint.h>
+#include <vector>
+
+#define SIMPLE_BUS_HISTOGRAM_SUB_BITS 5
+
+class simple_bus_histogram
+{
+public:
+  // constructor
+  simple_bus_histogram()
+    : m_count(0)
+    , m_sum(0)
+    , m_min(0)
+    , m_max(0)
+  {}
+
+  void record(uint64_t value);
+
+  uint64_t count() const { return m_count; }
+  uint64_t min() const { return m_min; }
+  uint64_t max() const { return m_max; }
+  double mean() const;
+
+  // smallest recorded value v such that percent % of all values are
+  // <= v, within the bucket resolution (0 if the histogram is empty)
+  uint64_t percentile(double percent) const;
+
+private:
+  static unsigned int bucket_index(uint64_t value);
+  static uint64_t bucket_upper(unsigned int index);
+
+  std::vector<uint64_t> m_buckets;
+  uint64_t m_count;
+  uint64_t m_sum;
+  uint64_t m_min;
+  uint64_t m_max;
+
+}; // end class simple_bus_histogram
+
+inline unsigned int simple_bus_histogram::bucket_index(uint64_t value)
+{
+  const uint64_t sub_buckets = 1ULL << SIMPLE_BUS_HISTOGRAM_SUB_BITS;
+  if (value < 2*sub_buckets)
+    return (unsigned int)value;
+  unsigned int msb = 63;
+  while (!(value >> msb))
+    --msb;
+  // value >> shift lies in [S, 2S): the bucket within the octave
+  unsigned int shift = msb - SIMPLE_BUS_HISTOGRAM_SUB_BITS;
+  return (unsigned int)(shift*sub_buckets + (value >> shift));
+}
+
+inline uint64_t simple_bus_histogram::bucket_upper(unsigned int index)
+{
+  const uint64_t sub_buckets = 1ULL << SIMPLE_BUS_HISTOGRAM_SUB_BITS;
+  if (index < 2*sub_buckets)
+    return index;
+  unsigned int shift = (unsigned int)(index / sub_buckets) - 1;
+  uint64_t mantissa = index - shift*sub_buckets;
+  return (mantissa << shift) + ((1ULL << shift) - 1);
+}
+
+inline void simple_bus_histogram::record(uint64_t value)
+{
+  unsigned int index = bucket_index(value);
+  if (index >= m_buckets.size())
+    m_buckets.resize(index + 1, 0);
+  m_buckets[index]++;
+  if ((m_count == 0) || (value < m_min))
+    m_min = value;
+  if (value > m_max)
+    m_max = value;
+  m_count++;
+  m_sum += value;
+}
+
+inline double simple_bus_histogram::mean() const
+{
+  return m_count ? (double)m_sum / m_count : 0.0;
+}
+
+inline uint64_t simple_bus_histogram::percentile(double percent) const
+{
+  if (m_count == 0)
+    return 0;
+  uint64_t target = (uint64_t)(percent / 100.0 * m_count + 0.5);
+  if (target < 1)
+    target = 1;
+  uint64_t seen = 0;
+  for (unsigned int i = 0; i < m_buckets.size(); ++i)
+    {
+      seen += m_buckets[i];
+      if (seen >= target)
+	{
+	  uint64_t value = bucket_upper(i);
+	  if (value > m_max) value = m_max;
+	  if (value < m_min) value = m_min;
+	  return value;
+	}
+    }
+  return m_max;
+}
+
+#endif
@@ -0,0 +1,65 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_lt_if.h : The loosely-timed BUS interface.
+
+		 b_transport moves a whole burst at once, without
+		 waiting for the clock: the data goes through the direct
+		 interface of the slaves, and the time the transfer
+		 would take on the bus is added to the annotated delay.
+		 The caller keeps its own local time and synchronizes
+		 with the kernel only when its quantum is used up (see
+		 simple_bus_quantum_keeper).
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#ifndef __simple_bus_lt_if_h
+#define __simple_bus_lt_if_h
+
+#include <systemc.h>
+
+#include "simple_bus_types.h"
+
+class simple_bus_lt_if
+  : public virtual sc_interface
+{
+public:
+  // loosely-timed BUS interface: delay is the local time offset of the
+  // caller on entry, and is increased by the duration of the transfer
+  virtual simple_bus_status b_transport(bool do_write
+					, int *data
+					, unsigned int start_address
+					, unsigned int length
+					, sc_time &delay) = 0;
+
+}; // end class simple_bus_lt_if
+
+#endif
@@ -20,6 +20,10 @@
 /*****************************************************************************
  
   simple_bus_main.cpp : sc_main
+
+		 Without arguments it runs the original test bench for
+		 10000 ns; the arguments describe another platform, see
+		 simple_bus_platform.h.
  
   Original Author: Ric Hilderink, Synopsys, Inc., 2001-10-11
  
@@ -37,21 +41,66 @@
 
  #include "systemc.h"
  #include "simple_bus_test.h"
+ #include "simple_bus_platform.h"
  
- int sc_main(int, char **)
+ int sc_main(int argc, char *argv[])
  {
-   simple_bus_test top("top");
+   // platform from the command line, see simple_bus_platform.h
+   simple_bus_platform_config config;
+   if (!config.parse_arguments(argc, argv)) {
+     simple_bus_platform_config::usage(argv[0]);
+     return 1;
+   }
+
+   simple_bus_test top("top", config);
+   if (!config.restore_file.empty() &&
+       !simple_bus_snapshot::restore(config.restore_file.c_str()))
+     return 1;
  
-   sc_start(10000, SC_NS);
+   sc_start(config.duration, SC_NS);
+
+   // checkpoint: run on to the end of the transfers in flight
+   if (!config.snapshot_file.empty()) {
+     const unsigned int max_cycles = 10000;
+     unsigned int cycles = 0;
+     for (; (cycles < max_cycles) && !simple_bus_snapshot::ready(&top); ++cycles)
+       sc_start(config.clock_period, SC_NS);
+     if (!simple_bus_snapshot::ready(&top)) {
+       sb_fprintf(stdout, "Error: transfers still in flight after %u cycles, no snapshot in %s\n"
+                  , max_cycles, config.snapshot_file.c_str());
+       sc_stop();
+       return 1;
+     }
+     if (!simple_bus_snapshot::save(config.snapshot_file.c_str(), &top)) {
+       sc_stop();
+       return 1;
+     }
+   }
    
    // Forzar una llamada a end_of_simulation
    sc_stop();
    
    // Reportar métricas del bus
-   top.bus->report_bus_utilization();
+   top.report_bus_utilization();
    
    // Reportar métricas de eficiencia de arbitraje
-   top.arbiter->report_arbitration_efficiency();
+   if (top.arbiter)
+     top.arbiter->report_arbitration_efficiency();
+   else
+     top.fast_arbiter->report_arbitration_efficiency();
+
+   if (!config.metrics_file.empty())
+     simple_bus_metrics_registry::write_json(config.metrics_file.c_str());
+
+   // windowed time series of the bus
+   if (top.sampler) {
+     if (!config.samples_csv_file.empty() &&
+         !top.sampler->write_csv(config.samples_csv_file.c_str()))
+       sb_fprintf(stdout, "Error: cannot write %s\n", config.samples_csv_file.c_str());
+     if (!config.samples_vcd_file.empty() &&
+         !top.sampler->write_vcd(config.samples_vcd_file.c_str()))
+       sb_fprintf(stdout, "Error: cannot write %s\n", config.samples_vcd_file.c_str());
+   }
  
    return 0;
  }
\ No newline at end of file
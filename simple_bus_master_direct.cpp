@@ -36,20 +36,20 @@
  
  *****************************************************************************/
 
+#include <string.h>
+
 #include "simple_bus_master_direct.h"
 #include "simple_bus_types.h"
 
 void simple_bus_master_direct::main_action()
 {
   int mydata[4];
+  bus_port->register_dmi_listener(this);
   while (true)
     {
-      bus_port->direct_read(&mydata[0], m_address);
-      bus_port->direct_read(&mydata[1], m_address+4);
-      bus_port->direct_read(&mydata[2], m_address+8);
-      bus_port->direct_read(&mydata[3], m_address+12);
+      read_words(mydata, m_address, 4);
 
-      if (m_verbose)
+      if (sb_logging && m_verbose)
       	sb_fprintf(stdout, "%s %s : mem[%x:%x] = (%x, %x, %x, %x)\n",
 		      sc_time_stamp().to_string().c_str(), name(), m_address, 
 		      m_address+15, 
@@ -58,3 +58,58 @@ void simple_bus_master_direct::main_action()
       wait(m_timeout, SC_NS);
     }
 }
+
+void simple_bus_master_direct::read_words(int *data
+					  , unsigned int address
+					  , unsigned int length)
+{
+  // copy whole runs of words through the DMI pointers; regions which
+  // do not grant direct memory access go through direct_read
+  while (length > 0)
+    {
+      const simple_bus_dmi *dmi = (const simple_bus_dmi *)0;
+      for (unsigned int i = 0; i < m_dmi_regions.size(); ++i)
+	if (m_dmi_regions[i].contains(address))
+	  {
+	    dmi = &m_dmi_regions[i];
+	    break;
+	  }
+      if (!dmi)
+	{
+	  simple_bus_dmi region;
+	  if (bus_port->get_direct_mem_ptr(address, region) &&
+	      region.read_allowed)
+	    {
+	      m_dmi_regions.push_back(region);
+	      dmi = &m_dmi_regions.back();
+	    }
+	}
+      if (!dmi)
+	{
+	  bus_port->direct_read(data, address);
+	  data++;
+	  address += 4;
+	  length--;
+	  continue;
+	}
+
+      unsigned int n = (dmi->end_address - address)/4 + 1;
+      if (n > length)
+	n = length;
+      memcpy(data, dmi->ptr + (address - dmi->start_address)/4, n*sizeof(int));
+      data += n;
+      address += n*4;
+      length -= n;
+    }
+}
+
+void simple_bus_master_direct::invalidate_direct_mem_ptr(unsigned int start_address
+							 , unsigned int end_address)
+{
+  for (unsigned int i = 0; i < m_dmi_regions.size(); )
+    if ((m_dmi_regions[i].start_address <= end_address) &&
+	(start_address <= m_dmi_regions[i].end_address))
+      m_dmi_regions.erase(m_dmi_regions.begin() + i);
+    else
+      ++i;
+}
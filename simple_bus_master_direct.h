@@ -40,12 +40,16 @@
 #define __simple_bus_master_direct_h
 
 #include <systemc.h>
+#include <vector>
 
 #include "simple_bus_direct_if.h"
 
 
-SC_MODULE(simple_bus_master_direct)
+class simple_bus_master_direct
+  : public simple_bus_dmi_invalidate_if
+  , public sc_module
 {
+public:
   // ports
   sc_in_clk clock;
   sc_port<simple_bus_direct_if> bus_port;
@@ -68,10 +72,17 @@ SC_MODULE(simple_bus_master_direct)
   // process
   void main_action();
 
+  // DMI invalidation from the bus
+  void invalidate_direct_mem_ptr(unsigned int start_address
+				 , unsigned int end_address);
+
 private:
+  void read_words(int *data, unsigned int address, unsigned int length);
+
   unsigned int m_address;
   int m_timeout;
   bool m_verbose;
+  std::vector<simple_bus_dmi> m_dmi_regions;
 
 }; // end class simple_bus_master_direct
 
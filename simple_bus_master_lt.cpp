@@ -0,0 +1,74 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_master_lt.cpp : The master using the loosely-timed BUS interface.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#include "simple_bus_master_lt.h"
+
+void simple_bus_master_lt::main_action()
+{
+  const unsigned int mylength = 0x10; // storage capacity/burst length in words
+  int mydata[mylength];
+  unsigned int i;
+  simple_bus_status status;
+  sc_time delay;
+
+  while (true)
+    {
+      delay = m_quantum_keeper.get_local_time();
+      status = bus_port->b_transport(false, mydata, m_address, mylength, delay);
+      m_quantum_keeper.set(delay);
+      if (status == SIMPLE_BUS_ERROR)
+	sb_fprintf(stdout, "%s %s : lt-read failed at address %x\n",
+		   m_quantum_keeper.get_current_time().to_string().c_str(), 
+		   name(), m_address);
+
+      for (i = 0; i < mylength; ++i)
+	{
+	  mydata[i] += i;
+	  m_quantum_keeper.inc(m_cycle_time);
+	}
+
+      delay = m_quantum_keeper.get_local_time();
+      status = bus_port->b_transport(true, mydata, m_address, mylength, delay);
+      m_quantum_keeper.set(delay);
+      if (status == SIMPLE_BUS_ERROR)
+	sb_fprintf(stdout, "%s %s : lt-write failed at address %x\n",
+		   m_quantum_keeper.get_current_time().to_string().c_str(), 
+		   name(), m_address);
+
+      m_quantum_keeper.inc(sc_time(m_timeout, SC_NS));
+      if (m_quantum_keeper.need_sync())
+	m_quantum_keeper.sync();
+    }
+}
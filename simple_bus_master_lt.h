@@ -0,0 +1,81 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_master_lt.h : The master using the loosely-timed BUS interface.
+
+		 Does the same work as simple_bus_master_blocking (read
+		 a burst, modify it word by word, write it back, idle
+		 for timeout ns), but through b_transport and with a
+		 quantum keeper instead of waiting for every clock edge.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#ifndef __simple_bus_master_lt_h
+#define __simple_bus_master_lt_h
+
+#include <systemc.h>
+
+#include "simple_bus_types.h"
+#include "simple_bus_lt_if.h"
+#include "simple_bus_quantum_keeper.h"
+
+
+SC_MODULE(simple_bus_master_lt)
+{
+  // ports
+  sc_port<simple_bus_lt_if> bus_port;
+
+  // constructor
+  simple_bus_master_lt(sc_module_name name_
+		       , unsigned int address
+		       , int timeout
+		       , const sc_time &cycle_time)
+    : sc_module(name_)
+    , m_address(address)
+    , m_timeout(timeout)
+    , m_cycle_time(cycle_time)
+  {
+    // process declaration
+    SC_THREAD(main_action);
+  }
+  
+  // process
+  void main_action();
+
+private:
+  unsigned int m_address;
+  int m_timeout;
+  sc_time m_cycle_time; // time to modify one word
+  simple_bus_quantum_keeper m_quantum_keeper;
+
+}; // end class simple_bus_master_lt
+
+#endif
@@ -0,0 +1,145 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  simple_bus_memory.h : Base class of the memory slaves.
+
+		 Holds the backing store and the address range of a
+		 memory, and implements what does not depend on its
+		 timing: direct memory access (regions, listeners,
+		 granting and revoking), memory images and the
+		 checkpoint of the contents. The memories add the slave
+		 interface and, when they have more state than the
+		 contents, extend save_state/restore_state.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+
+      Name, Affiliation, Date:
+  Description of Modification:
+
+ *****************************************************************************/
+
+#ifndef __simple_bus_memory_h
+#define __simple_bus_memory_h
+
+#include <stdint.h>
+#include <stdio.h>
+#include <systemc.h>
+
+#include "simple_bus_slave_if.h"
+#include "simple_bus_backing_store.h"
+#include "simple_bus_snapshot.h"
+
+
+class simple_bus_memory
+  : public simple_bus_slave_if
+  , public simple_bus_snapshot_if
+{
+public:
+  // direct memory interface
+  bool get_direct_mem_ptr(unsigned int address, simple_bus_dmi &dmi);
+  void register_dmi_listener(simple_bus_dmi_invalidate_if *listener);
+
+  // grant or revoke direct memory access; revoking invalidates all
+  // pointers handed out so far
+  void allow_direct_mem_access(bool allow);
+
+  // back the memory with an image file, see
+  // simple_bus_backing_store::map_file; revokes direct memory access
+  // pointers handed out so far
+  bool map_file(const char *file_name, bool shared = false);
+
+  // checkpoints: the contents
+  bool save_state(FILE *file) const;
+  bool restore_state(FILE *file);
+
+protected:
+  simple_bus_memory(unsigned int start_address
+		    , unsigned int end_address
+		    , unsigned int data_width)
+    : MEM((uint64_t)end_address - start_address + 1)
+    , m_start_address(start_address)
+    , m_end_address(end_address)
+    , m_data_width(data_width)
+    , m_dmi_allowed(true)
+  {
+    sc_assert(m_start_address <= m_end_address);
+    sc_assert((m_end_address-m_start_address+1)%4 == 0);
+    sc_assert((m_data_width >= 4) && !(m_data_width & (m_data_width - 1)));
+  }
+
+  simple_bus_backing_store MEM;
+  unsigned int m_start_address;
+  unsigned int m_end_address;
+  unsigned int m_data_width;
+  bool m_dmi_allowed;
+  simple_bus_dmi_listeners m_dmi_listeners;
+
+}; // end class simple_bus_memory
+
+inline bool simple_bus_memory::get_direct_mem_ptr(unsigned int address
+						  , simple_bus_dmi &dmi)
+{
+  if (!m_dmi_allowed)
+    return false;
+  // the contiguous run of the backing store around address
+  unsigned int first, last;
+  dmi.ptr = MEM.region(address - m_start_address, first, last);
+  dmi.start_address = m_start_address + first;
+  dmi.end_address = m_start_address + last;
+  dmi.read_allowed = true;
+  dmi.write_allowed = true;
+  return true;
+}
+
+inline void simple_bus_memory::register_dmi_listener(simple_bus_dmi_invalidate_if *listener)
+{
+  m_dmi_listeners.add(listener);
+}
+
+inline void simple_bus_memory::allow_direct_mem_access(bool allow)
+{
+  if (m_dmi_allowed && !allow)
+    m_dmi_listeners.invalidate(m_start_address, m_end_address);
+  m_dmi_allowed = allow;
+}
+
+inline bool simple_bus_memory::map_file(const char *file_name, bool shared)
+{
+  m_dmi_listeners.invalidate(m_start_address, m_end_address);
+  return MEM.map_file(file_name, shared);
+}
+
+inline bool simple_bus_memory::save_state(FILE *file) const
+{
+  return MEM.save(file);
+}
+
+inline bool simple_bus_memory::restore_state(FILE *file)
+{
+  return MEM.restore(file);
+}
+
+#endif
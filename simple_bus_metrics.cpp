@@ -0,0 +1,268 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_metrics.cpp : Per-instance bus metrics and their registry.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#include "simple_bus_metrics.h"
+
+//----------------------------------------------------------------------------
+//-- simple_bus_metrics
+//----------------------------------------------------------------------------
+
+simple_bus_metrics::simple_bus_metrics(const char *name)
+  : m_name(name)
+{
+  simple_bus_metrics_registry::add(this);
+}
+
+simple_bus_metrics::~simple_bus_metrics()
+{
+  simple_bus_metrics_registry::remove(this);
+}
+
+static void write_indent(FILE *file, unsigned int indent)
+{
+  for (unsigned int i = 0; i < indent; ++i)
+    fputs("  ", file);
+}
+
+static void write_histogram(FILE *file, const simple_bus_histogram &histogram)
+{
+  fprintf(file, "{\"count\": %llu, \"mean\": %.1f, \"min\": %llu, "
+	  "\"p50\": %llu, \"p90\": %llu, \"p99\": %llu, \"max\": %llu}",
+	  (unsigned long long)histogram.count(), histogram.mean(),
+	  (unsigned long long)histogram.min(),
+	  (unsigned long long)histogram.percentile(50),
+	  (unsigned long long)histogram.percentile(90),
+	  (unsigned long long)histogram.percentile(99),
+	  (unsigned long long)histogram.max());
+}
+
+static void write_histograms(FILE *file, unsigned int indent, const char *key
+			     , const std::map<unsigned int, simple_bus_histogram> &histograms)
+{
+  write_indent(file, indent);
+  fprintf(file, "\"%s\": {", key);
+  const char *separator = "\n";
+  for (std::map<unsigned int, simple_bus_histogram>::const_iterator it =
+	 histograms.begin(); it != histograms.end(); ++it)
+    {
+      fputs(separator, file);
+      write_indent(file, indent + 1);
+      fprintf(file, "\"%u\": ", it->first);
+      write_histogram(file, it->second);
+      separator = ",\n";
+    }
+  if (!histograms.empty())
+    {
+      fputc('\n', file);
+      write_indent(file, indent);
+    }
+  fputc('}', file);
+}
+
+void simple_bus_metrics::write_json(FILE *file, unsigned int indent) const
+{
+  const struct { const char *key; const simple_bus_counter *counter; } counters[] = {
+    { "bytes_transferred", &bytes_transferred },
+    { "transactions", &transactions },
+    { "read_transactions", &read_transactions },
+    { "write_transactions", &write_transactions },
+    { "read_transfers_started", &read_transfers_started },
+    { "write_transfers_started", &write_transfers_started },
+    { "arbitrations", &arbitrations },
+    { "arbitration_rejections", &arbitration_rejections },
+    { "posted_writes", &posted_writes },
+    { "forwarded_reads", &forwarded_reads },
+    { "write_stall_cycles", &write_stall_cycles },
+    { "read_stall_cycles", &read_stall_cycles },
+    { "active_time_ps", &active_time },
+    { "read_time_ps", &read_time },
+    { "write_time_ps", &write_time },
+    { "simulation_time_ps", &simulation_time }
+  };
+
+  fputs("{\n", file);
+  for (unsigned int i = 0; i < sizeof(counters)/sizeof(counters[0]); ++i)
+    {
+      write_indent(file, indent + 1);
+      fprintf(file, "\"%s\": %llu,\n", counters[i].key,
+	      (unsigned long long)counters[i].counter->get());
+    }
+  write_indent(file, indent + 1);
+  fputs("\"read_latency_ps\": ", file);
+  write_histogram(file, read_latency);
+  fputs(",\n", file);
+  write_indent(file, indent + 1);
+  fputs("\"write_latency_ps\": ", file);
+  write_histogram(file, write_latency);
+  fputs(",\n", file);
+  write_histograms(file, indent + 1, "master_latency_ps", master_latency);
+  fputs(",\n", file);
+  write_histograms(file, indent + 1, "slave_latency_ps", slave_latency);
+  fputs(",\n", file);
+  write_indent(file, indent + 1);
+  fputs("\"posted_occupancy\": ", file);
+  write_histogram(file, posted_occupancy);
+  fputc('\n', file);
+  write_indent(file, indent);
+  fputc('}', file);
+}
+
+//----------------------------------------------------------------------------
+//-- simple_bus_metrics_registry
+//----------------------------------------------------------------------------
+
+std::mutex &simple_bus_metrics_registry::lock()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::map<std::string, simple_bus_metrics *> &simple_bus_metrics_registry::entries()
+{
+  static std::map<std::string, simple_bus_metrics *> metrics;
+  return metrics;
+}
+
+void simple_bus_metrics_registry::add(simple_bus_metrics *metrics)
+{
+  std::lock_guard<std::mutex> guard(lock());
+  // module names are unique, so a clash is a second bus object for
+  // the same module: the newest one wins
+  entries()[metrics->name()] = metrics;
+}
+
+void simple_bus_metrics_registry::remove(simple_bus_metrics *metrics)
+{
+  std::lock_guard<std::mutex> guard(lock());
+  std::map<std::string, simple_bus_metrics *>::iterator it =
+    entries().find(metrics->name());
+  if ((it != entries().end()) && (it->second == metrics))
+    entries().erase(it);
+}
+
+simple_bus_metrics *simple_bus_metrics_registry::find(const std::string &name)
+{
+  std::lock_guard<std::mutex> guard(lock());
+  std::map<std::string, simple_bus_metrics *>::const_iterator it =
+    entries().find(name);
+  return (it != entries().end()) ? it->second : (simple_bus_metrics *)0;
+}
+
+std::vector<simple_bus_metrics *>
+simple_bus_metrics_registry::find_all(const std::string &prefix)
+{
+  std::lock_guard<std::mutex> guard(lock());
+  std::vector<simple_bus_metrics *> result;
+  for (std::map<std::string, simple_bus_metrics *>::const_iterator it =
+	 entries().lower_bound(prefix); it != entries().end(); ++it)
+    {
+      const std::string &name = it->first;
+      if (name.compare(0, prefix.size(), prefix) != 0)
+	break;
+      // "top.bus" is below "top", but "top.bus2" is not below "top.bus"
+      if (prefix.empty() || (name.size() == prefix.size()) ||
+	  (name[prefix.size()] == '.'))
+	result.push_back(it->second);
+    }
+  return result;
+}
+
+static std::vector<std::string> split_name(const std::string &name)
+{
+  std::vector<std::string> parts;
+  std::string::size_type begin = 0, end;
+  while ((end = name.find('.', begin)) != std::string::npos)
+    {
+      parts.push_back(name.substr(begin, end - begin));
+      begin = end + 1;
+    }
+  parts.push_back(name.substr(begin));
+  return parts;
+}
+
+void simple_bus_metrics_registry::write_json(FILE *file)
+{
+  std::vector<simple_bus_metrics *> metrics = find_all();
+
+  // the names are sorted, so walking them in order opens and closes
+  // the objects of the hierarchy like a depth-first traversal
+  std::vector<std::string> open;
+  fputc('{', file);
+  bool first = true;
+  for (unsigned int i = 0; i < metrics.size(); ++i)
+    {
+      std::vector<std::string> parts = split_name(metrics[i]->name());
+      unsigned int common = 0;
+      while ((common < open.size()) && (common + 1 < parts.size()) &&
+	     (open[common] == parts[common]))
+	++common;
+      while (open.size() > common)
+	{
+	  open.pop_back();
+	  fputc('\n', file);
+	  write_indent(file, open.size() + 1);
+	  fputc('}', file);
+	}
+      fputs(first ? "\n" : ",\n", file);
+      first = false;
+      for (unsigned int p = common; p + 1 < parts.size(); ++p)
+	{
+	  write_indent(file, open.size() + 1);
+	  fprintf(file, "\"%s\": {\n", parts[p].c_str());
+	  open.push_back(parts[p]);
+	}
+      write_indent(file, open.size() + 1);
+      fprintf(file, "\"%s\": ", parts.back().c_str());
+      metrics[i]->write_json(file, open.size() + 1);
+    }
+  while (!open.empty())
+    {
+      open.pop_back();
+      fputc('\n', file);
+      write_indent(file, open.size() + 1);
+      fputc('}', file);
+    }
+  fputs("\n}\n", file);
+}
+
+bool simple_bus_metrics_registry::write_json(const char *file_name)
+{
+  FILE *file = fopen(file_name, "w");
+  if (!file)
+    return false;
+  write_json(file);
+  fclose(file);
+  return true;
+}
@@ -0,0 +1,167 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_metrics.h : Per-instance bus metrics and their registry.
+
+		 Every bus owns a simple_bus_metrics object named after
+		 the bus module. The object registers itself in
+		 simple_bus_metrics_registry under that hierarchical
+		 name, so a platform with several buses keeps separate
+		 numbers, which can be looked up by name at runtime or
+		 dumped as one JSON document following the module
+		 hierarchy.
+
+		 The counters are relaxed atomics: each value can be read
+		 from any thread while the simulation runs (no snapshot
+		 across counters). The latency histograms are plain
+		 objects, read them while the simulation is paused.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#ifndef __simple_bus_metrics_h
+#define __simple_bus_metrics_h
+
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <systemc.h>
+
+#include "simple_bus_histogram.h"
+
+// lock-free event/byte/time counter
+class simple_bus_counter
+{
+public:
+  simple_bus_counter() : m_value(0) {}
+
+  void add(uint64_t n) { m_value.fetch_add(n, std::memory_order_relaxed); }
+  void set(uint64_t n) { m_value.store(n, std::memory_order_relaxed); }
+  uint64_t get() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<uint64_t> m_value;
+};
+
+// sc_time in ps, the unit of all time counters and histograms. Exact
+// from the integer tick count at a time resolution of 1 ps or finer
+// (SystemC's default is 1 ps); a coarser resolution goes through double.
+inline uint64_t sb_time_ps(const sc_time &t)
+{
+  // the resolution is fixed once the first sc_time exists
+  static const uint64_t ticks_per_ps = sc_time(1, SC_PS).value();
+  if (ticks_per_ps > 0)
+    return (t.value() + ticks_per_ps / 2) / ticks_per_ps;
+  return (uint64_t)(t.to_seconds() * 1e12 + 0.5);
+}
+
+class simple_bus_metrics
+{
+public:
+  // constructor: registers under name (the bus module name)
+  explicit simple_bus_metrics(const char *name);
+
+  // destructor: unregisters
+  ~simple_bus_metrics();
+
+  const std::string &name() const { return m_name; }
+
+  // traffic (a transaction is one beat)
+  simple_bus_counter bytes_transferred;
+  simple_bus_counter transactions;
+  simple_bus_counter read_transactions;
+  simple_bus_counter write_transactions;
+  simple_bus_counter read_transfers_started;   // direct interface
+  simple_bus_counter write_transfers_started;  // direct interface
+  simple_bus_counter arbitrations;
+  simple_bus_counter arbitration_rejections;   // requests not selected
+
+  // posted writes (simple_bus::set_posted_writes)
+  simple_bus_counter posted_writes;            // accepted into the FIFO
+  simple_bus_counter forwarded_reads;          // answered from the FIFO
+  simple_bus_counter write_stall_cycles;       // per request: FIFO full
+  simple_bus_counter read_stall_cycles;        // per request: overlaps the FIFO
+
+  // times in ps
+  simple_bus_counter active_time;      // the bus served a request
+  simple_bus_counter read_time;        // summed read request latency
+  simple_bus_counter write_time;       // summed write request latency
+  simple_bus_counter simulation_time;  // set at end of simulation
+
+  // request latencies in ps, per access type, master (priority) and
+  // slave (port index)
+  simple_bus_histogram read_latency;
+  simple_bus_histogram write_latency;
+  std::map<unsigned int, simple_bus_histogram> master_latency;
+  std::map<unsigned int, simple_bus_histogram> slave_latency;
+
+  // entries in the posted-write FIFO, sampled every active bus cycle
+  simple_bus_histogram posted_occupancy;
+
+  // the fields of this bus as a JSON object
+  void write_json(FILE *file, unsigned int indent = 0) const;
+
+private:
+  // not copyable, the registry keeps a pointer
+  simple_bus_metrics(const simple_bus_metrics &);
+  simple_bus_metrics &operator=(const simple_bus_metrics &);
+
+  std::string m_name;
+};
+
+class simple_bus_metrics_registry
+{
+public:
+  // metrics of the bus with the given module name, 0 if there is none
+  static simple_bus_metrics *find(const std::string &name);
+
+  // all metrics at or below a point of the hierarchy ("" for all),
+  // sorted on name
+  static std::vector<simple_bus_metrics *> find_all(const std::string &prefix = "");
+
+  // all metrics as one JSON object nested along the module hierarchy,
+  // e.g. {"top": {"bus": {...}}}
+  static void write_json(FILE *file);
+  static bool write_json(const char *file_name);
+
+private:
+  friend class simple_bus_metrics;
+  static void add(simple_bus_metrics *metrics);
+  static void remove(simple_bus_metrics *metrics);
+
+  static std::mutex &lock();
+  static std::map<std::string, simple_bus_metrics *> &entries();
+};
+
+#endif
@@ -55,6 +55,13 @@ public:
 		     , int *data
 		     , unsigned int address
 		     , bool lock = false) = 0;
+  // sub-word write: only the bytes enabled in byte_enable (bit i is
+  // byte i of the word) are written
+  virtual void write_bytes(unsigned int unique_priority
+			   , int *data
+			   , unsigned int address
+			   , unsigned int byte_enable
+			   , bool lock = false) = 0;
 
   virtual simple_bus_status get_status(unsigned int unique_priority) = 0;
 
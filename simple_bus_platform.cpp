@@ -0,0 +1,602 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_platform.cpp : Configuration file and command line parsing
+                            of the test platform.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <set>
+
+#include "simple_bus_platform.h"
+
+const char *simple_bus_bus_type_str[2] = { "shared"
+					   , "crossbar"
+};
+
+const char *simple_bus_arbiter_type_str[2] = { "standard"
+					       , "fast"
+};
+
+const char *simple_bus_master_type_str[4] = { "blocking"
+					      , "non_blocking"
+					      , "direct"
+					      , "lt"
+};
+
+const char *simple_bus_memory_type_str[4] = { "fast"
+					      , "slow"
+					      , "clockless"
+					      , "dram"
+};
+
+simple_bus_platform_config::simple_bus_platform_config()
+  : clock_period(1.0)
+  , duration(10000.0)
+  , sample_window(0)
+  , bus_type(SIMPLE_BUS_BUS_SHARED)
+  , data_width(4)
+  , bus_verbose(false)
+  , split_transactions(false)
+  , posted_writes(0)
+  , arbiter(SIMPLE_BUS_ARBITER_STANDARD)
+  , policy(SIMPLE_BUS_ARB_PRIORITY)
+  , tdma_slot(0.0)
+  , arbiter_verbose(false)
+  , m_default_masters(true)
+  , m_default_memories(true)
+{
+  // the original test bench
+  add_master();
+  set("master", "type", "blocking");
+  set("master", "priority", "4");
+  set("master", "address", "0x4c");
+  set("master", "timeout", "300");
+  add_master();
+  set("master", "type", "non_blocking");
+  set("master", "priority", "3");
+  set("master", "address", "0x38");
+  set("master", "timeout", "20");
+  add_master();
+  set("master", "type", "direct");
+  set("master", "address", "0x78");
+  set("master", "timeout", "100");
+  add_memory();
+  set("memory", "type", "slow");
+  set("memory", "start", "0x80");
+  set("memory", "size", "0x80");
+  set("memory", "wait_states", "1");
+  add_memory();
+  set("memory", "type", "fast");
+  set("memory", "start", "0x00");
+  set("memory", "size", "0x80");
+  m_default_masters = true;
+  m_default_memories = true;
+}
+
+void simple_bus_platform_config::add_master()
+{
+  if (m_default_masters)
+    {
+      masters.clear();
+      m_default_masters = false;
+    }
+  simple_bus_master_config master;
+  master.type = SIMPLE_BUS_MASTER_BLOCKING;
+  master.count = 1;
+  master.priority = 1;
+  master.address = 0;
+  master.stride = 0;
+  master.lock = false;
+  master.timeout = 100;
+  master.weight = 1;
+  master.verbose = true;
+  masters.push_back(master);
+}
+
+void simple_bus_platform_config::add_memory()
+{
+  if (m_default_memories)
+    {
+      memories.clear();
+      m_default_memories = false;
+    }
+  simple_bus_memory_config memory;
+  memory.type = SIMPLE_BUS_MEMORY_FAST;
+  memory.count = 1;
+  memory.start_address = 0;
+  memory.size = 0x80;
+  memory.nr_wait_states = 1;
+  memory.data_width = 4;
+  memory.shared = false;
+  memory.cache_size = 0;
+  memory.cache_line = 32;
+  memory.cache_ways = 2;
+  memory.cache_policy = SIMPLE_BUS_CACHE_WRITE_BACK;
+  memory.cache_hit_wait_states = 0;
+  memory.cache_miss_wait_states = 8;
+  memory.nr_banks = 4;
+  memory.row_size = 1024;
+  memory.trcd = 3;
+  memory.tcas = 3;
+  memory.trp = 3;
+  memory.window = 1;
+  memories.push_back(memory);
+}
+
+static bool parse_unsigned(const std::string &value, unsigned int &result)
+{
+  char *end;
+  errno = 0;
+  unsigned long number = strtoul(value.c_str(), &end, 0);
+  if (value.empty() || (*end != '\0') || (value[0] == '-') ||
+      (errno == ERANGE) || (number > UINT_MAX))
+    return false;
+  result = (unsigned int)number;
+  return true;
+}
+
+static bool parse_double(const std::string &value, double &result)
+{
+  char *end;
+  result = strtod(value.c_str(), &end);
+  return !value.empty() && (*end == '\0') && (result >= 0.0);
+}
+
+static bool parse_bool(const std::string &value, bool &result)
+{
+  if ((value == "1") || (value == "true") || (value == "yes") || (value == "on"))
+    result = true;
+  else if ((value == "0") || (value == "false") || (value == "no") || (value == "off"))
+    result = false;
+  else
+    return false;
+  return true;
+}
+
+static bool parse_enum(const std::string &value, const char **names
+		       , unsigned int nr_names, unsigned int &result)
+{
+  for (unsigned int i = 0; i < nr_names; ++i)
+    if (value == names[i])
+      {
+	result = i;
+	return true;
+      }
+  return false;
+}
+
+bool simple_bus_platform_config::set(const std::string &section
+				     , const std::string &key
+				     , const std::string &value)
+{
+  unsigned int number;
+  bool ok = false;
+  bool known = true;
+
+  if (section == "platform")
+    {
+      if (key == "clock")
+	ok = parse_double(value, clock_period) && (clock_period > 0.0);
+      else if (key == "duration")
+	ok = parse_double(value, duration) && (duration > 0.0);
+      else if (key == "metrics")
+	{ metrics_file = value; ok = true; }
+      else if (key == "restore")
+	{ restore_file = value; ok = true; }
+      else if (key == "snapshot")
+	{ snapshot_file = value; ok = true; }
+      else if (key == "sample_window")
+	ok = parse_unsigned(value, sample_window);
+      else if (key == "samples_csv")
+	{ samples_csv_file = value; ok = true; }
+      else if (key == "samples_vcd")
+	{ samples_vcd_file = value; ok = true; }
+      else
+	known = false;
+    }
+  else if (section == "bus")
+    {
+      if (key == "type")
+	{
+	  ok = parse_enum(value, simple_bus_bus_type_str, 2, number);
+	  if (ok)
+	    bus_type = (simple_bus_bus_type)number;
+	}
+      else if (key == "data_width")
+	ok = parse_unsigned(value, data_width) && (data_width >= 4) &&
+	  (data_width <= 32) && !(data_width & (data_width - 1));
+      else if (key == "verbose")
+	ok = parse_bool(value, bus_verbose);
+      else if (key == "split")
+	ok = parse_bool(value, split_transactions);
+      else if (key == "posted_writes")
+	ok = parse_unsigned(value, posted_writes);
+      else if (key == "trace")
+	{ trace_file = value; ok = true; }
+      else if (key == "arbiter")
+	{
+	  ok = parse_enum(value, simple_bus_arbiter_type_str, 2, number);
+	  if (ok)
+	    arbiter = (simple_bus_arbiter_type)number;
+	}
+      else
+	known = false;
+    }
+  else if (section == "arbiter")
+    {
+      if (key == "policy")
+	{
+	  ok = parse_enum(value, simple_bus_arbiter_policy_str, 4, number);
+	  if (ok)
+	    policy = (simple_bus_arbiter_policy)number;
+	}
+      else if (key == "tdma_slot")
+	ok = parse_double(value, tdma_slot);
+      else if (key == "verbose")
+	ok = parse_bool(value, arbiter_verbose);
+      else
+	known = false;
+    }
+  else if ((section == "master") && !masters.empty())
+    {
+      simple_bus_master_config &master = masters.back();
+      if (key == "type")
+	{
+	  ok = parse_enum(value, simple_bus_master_type_str, 4, number);
+	  if (ok)
+	    master.type = (simple_bus_master_type)number;
+	}
+      else if (key == "count")
+	ok = parse_unsigned(value, master.count) && (master.count > 0);
+      else if (key == "name")
+	{ master.name = value; ok = true; }
+      else if (key == "priority")
+	ok = parse_unsigned(value, master.priority);
+      else if (key == "address")
+	ok = parse_unsigned(value, master.address) && !(master.address & 3);
+      else if (key == "stride")
+	ok = parse_unsigned(value, master.stride) && !(master.stride & 3);
+      else if (key == "lock")
+	ok = parse_bool(value, master.lock);
+      else if (key == "timeout")
+	{
+	  ok = parse_unsigned(value, number);
+	  master.timeout = (int)number;
+	}
+      else if (key == "weight")
+	ok = parse_unsigned(value, master.weight) && (master.weight > 0);
+      else if (key == "verbose")
+	ok = parse_bool(value, master.verbose);
+      else
+	known = false;
+    }
+  else if ((section == "memory") && !memories.empty())
+    {
+      simple_bus_memory_config &memory = memories.back();
+      if (key == "type")
+	{
+	  ok = parse_enum(value, simple_bus_memory_type_str, 4, number);
+	  if (ok)
+	    memory.type = (simple_bus_memory_type)number;
+	}
+      else if (key == "count")
+	ok = parse_unsigned(value, memory.count) && (memory.count > 0);
+      else if (key == "name")
+	{ memory.name = value; ok = true; }
+      else if (key == "start")
+	ok = parse_unsigned(value, memory.start_address) && !(memory.start_address & 3);
+      else if (key == "size")
+	ok = parse_unsigned(value, memory.size) && (memory.size > 0) && !(memory.size & 3);
+      else if (key == "wait_states")
+	ok = parse_unsigned(value, memory.nr_wait_states);
+      else if (key == "data_width")
+	ok = parse_unsigned(value, memory.data_width) && (memory.data_width >= 4) &&
+	  !(memory.data_width & (memory.data_width - 1));
+      else if (key == "image")
+	{ memory.image = value; ok = true; }
+      else if (key == "shared")
+	ok = parse_bool(value, memory.shared);
+      else if (key == "cache_size")
+	ok = parse_unsigned(value, memory.cache_size) && !(memory.cache_size & (memory.cache_size - 1));
+      else if (key == "cache_line")
+	ok = parse_unsigned(value, memory.cache_line) && (memory.cache_line >= 4) &&
+	  !(memory.cache_line & (memory.cache_line - 1));
+      else if (key == "cache_ways")
+	ok = parse_unsigned(value, memory.cache_ways) && (memory.cache_ways > 0);
+      else if (key == "cache_policy")
+	{
+	  ok = parse_enum(value, simple_bus_cache_policy_str, 2, number);
+	  if (ok)
+	    memory.cache_policy = (simple_bus_cache_policy)number;
+	}
+      else if (key == "cache_hit")
+	ok = parse_unsigned(value, memory.cache_hit_wait_states);
+      else if (key == "cache_miss")
+	ok = parse_unsigned(value, memory.cache_miss_wait_states);
+      else if (key == "banks")
+	ok = parse_unsigned(value, memory.nr_banks) && (memory.nr_banks > 0);
+      else if (key == "row_size")
+	ok = parse_unsigned(value, memory.row_size) && (memory.row_size > 0) && !(memory.row_size & 3);
+      else if (key == "trcd")
+	ok = parse_unsigned(value, memory.trcd);
+      else if (key == "tcas")
+	ok = parse_unsigned(value, memory.tcas);
+      else if (key == "trp")
+	ok = parse_unsigned(value, memory.trp);
+      else if (key == "window")
+	ok = parse_unsigned(value, memory.window) && (memory.window > 0);
+      else
+	known = false;
+    }
+  else
+    {
+      sb_fprintf(stdout, "Error: unknown section [%s]\n", section.c_str());
+      return false;
+    }
+
+  if (!known)
+    sb_fprintf(stdout, "Error: unknown key %s.%s\n", section.c_str(), key.c_str());
+  else if (!ok)
+    sb_fprintf(stdout, "Error: invalid value %s.%s = %s\n"
+	       , section.c_str(), key.c_str(), value.c_str());
+  return known && ok;
+}
+
+static std::string trim(const std::string &text)
+{
+  const char *blanks = " \t\r\n";
+  std::string::size_type begin = text.find_first_not_of(blanks);
+  if (begin == std::string::npos)
+    return "";
+  return text.substr(begin, text.find_last_not_of(blanks) - begin + 1);
+}
+
+bool simple_bus_platform_config::read_file(const char *file_name)
+{
+  FILE *file = fopen(file_name, "r");
+  if (!file)
+    {
+      sb_fprintf(stdout, "Error: cannot open %s\n", file_name);
+      return false;
+    }
+
+  char buffer[512];
+  std::string section;
+  unsigned int line_nr = 0;
+  bool ok = true;
+  while (ok && fgets(buffer, sizeof(buffer), file))
+    {
+      ++line_nr;
+      std::string line(buffer);
+      std::string::size_type comment = line.find_first_of("#;");
+      if (comment != std::string::npos)
+	line.erase(comment);
+      line = trim(line);
+      if (line.empty())
+	continue;
+
+      if ((line[0] == '[') && (line[line.size() - 1] == ']'))
+	{
+	  section = trim(line.substr(1, line.size() - 2));
+	  if (section == "master")
+	    add_master();
+	  else if (section == "memory")
+	    add_memory();
+	  continue;
+	}
+
+      std::string::size_type equal = line.find('=');
+      if (equal == std::string::npos)
+	ok = false;
+      else
+	ok = set(section, trim(line.substr(0, equal)), trim(line.substr(equal + 1)));
+      if (!ok)
+	sb_fprintf(stdout, "Error: %s:%u: %s\n", file_name, line_nr, line.c_str());
+    }
+  fclose(file);
+  return ok;
+}
+
+void simple_bus_platform_config::usage(const char *program)
+{
+  sb_fprintf(stdout, "usage: %s [-f file.ini] [section.key=value ...]\n"
+	     "          [master=key=value,...] [memory=key=value,...]\n"
+	     "  e.g. %s platform.duration=20000 arbiter.policy=round-robin \\\n"
+	     "        master=type=blocking,count=4,priority=1,address=0x0,stride=0x40\n"
+	     "  keys: see simple_bus_platform.h\n", program, program);
+}
+
+bool simple_bus_platform_config::parse_arguments(int argc, char *argv[])
+{
+  for (int i = 1; i < argc; ++i)
+    {
+      std::string argument(argv[i]);
+      if (argument == "-f")
+	{
+	  if ((++i == argc) || !read_file(argv[i]))
+	    return false;
+	  continue;
+	}
+
+      std::string::size_type equal = argument.find('=');
+      if (equal == std::string::npos)
+	{
+	  sb_fprintf(stdout, "Error: invalid argument %s\n", argument.c_str());
+	  return false;
+	}
+      std::string name = argument.substr(0, equal);
+      std::string value = argument.substr(equal + 1);
+
+      if ((name == "master") || (name == "memory"))
+	{
+	  // a whole section: key=value,key=value,...
+	  if (name == "master")
+	    add_master();
+	  else
+	    add_memory();
+	  std::string::size_type begin = 0;
+	  while (begin <= value.size())
+	    {
+	      std::string::size_type end = value.find(',', begin);
+	      if (end == std::string::npos)
+		end = value.size();
+	      std::string setting = value.substr(begin, end - begin);
+	      std::string::size_type separator = setting.find('=');
+	      if ((separator == std::string::npos) ||
+		  !set(name, setting.substr(0, separator), setting.substr(separator + 1)))
+		{
+		  sb_fprintf(stdout, "Error: invalid argument %s\n", argument.c_str());
+		  return false;
+		}
+	      begin = end + 1;
+	    }
+	  continue;
+	}
+
+      std::string::size_type dot = name.find('.');
+      if ((dot == std::string::npos) ||
+	  !set(name.substr(0, dot), name.substr(dot + 1), value))
+	{
+	  sb_fprintf(stdout, "Error: invalid argument %s\n", argument.c_str());
+	  return false;
+	}
+    }
+  return check();
+}
+
+bool simple_bus_platform_config::check() const
+{
+  if ((sample_window == 0) &&
+      (!samples_csv_file.empty() || !samples_vcd_file.empty()))
+    {
+      sb_fprintf(stdout, "Error: samples_csv/samples_vcd need platform.sample_window\n");
+      return false;
+    }
+
+  if ((arbiter == SIMPLE_BUS_ARBITER_FAST) && (policy != SIMPLE_BUS_ARB_PRIORITY))
+    {
+      sb_fprintf(stdout, "Error: bus.arbiter = fast supports arbiter.policy = priority only\n");
+      return false;
+    }
+
+  // the crossbar has 32-bit layers and none of these simple_bus modes
+  if ((bus_type == SIMPLE_BUS_BUS_CROSSBAR) &&
+      ((data_width != 4) || split_transactions || (posted_writes > 0) ||
+       !trace_file.empty() || !snapshot_file.empty() || !restore_file.empty()))
+    {
+      sb_fprintf(stdout, "Error: bus.type = crossbar does not support data_width,"
+		 " split, posted_writes, trace, snapshot or restore\n");
+      return false;
+    }
+
+  // the bus keeps one request form per priority
+  std::set<unsigned int> priorities;
+  for (unsigned int i = 0; i < masters.size(); ++i)
+    {
+      const simple_bus_master_config &master = masters[i];
+      if ((master.type != SIMPLE_BUS_MASTER_BLOCKING) &&
+	  (master.type != SIMPLE_BUS_MASTER_NON_BLOCKING))
+	continue;
+      for (unsigned int j = 0; j < master.count; ++j)
+	if (!priorities.insert(master.priority + j).second)
+	  {
+	    sb_fprintf(stdout, "Error: priority %u is used by more than one master\n"
+		       , master.priority + j);
+	    return false;
+	  }
+    }
+  for (unsigned int i = 0; i < memories.size(); ++i)
+    if (!memories[i].image.empty() && memories[i].shared && (memories[i].count > 1))
+      {
+	sb_fprintf(stdout, "Error: shared image %s mapped by %u memories\n"
+		   , memories[i].image.c_str(), memories[i].count);
+	return false;
+      }
+  // restoring would write the snapshot into the image file
+  for (unsigned int i = 0; i < memories.size(); ++i)
+    if (!memories[i].image.empty() && memories[i].shared && !restore_file.empty())
+      {
+	sb_fprintf(stdout, "Error: cannot restore %s into the shared image %s\n"
+		   , restore_file.c_str(), memories[i].image.c_str());
+	return false;
+      }
+  for (unsigned int i = 0; i < memories.size(); ++i)
+    {
+      if (memories[i].type != SIMPLE_BUS_MEMORY_DRAM)
+	continue;
+      if (memories[i].row_size % memories[i].data_width)
+	{
+	  sb_fprintf(stdout, "Error: rows of %u bytes do not hold whole beats of %u bytes\n"
+		     , memories[i].row_size, memories[i].data_width);
+	  return false;
+	}
+      // the bus keeps more than one access at a slave only in split mode
+      if ((memories[i].window > 1) && !split_transactions)
+	{
+	  sb_fprintf(stdout, "Error: a dram window of %u needs bus.split = true\n"
+		     , memories[i].window);
+	  return false;
+	}
+      // behind a cache the bus sees the cache, which serves one
+      // access at a time
+      if ((memories[i].window > 1) && (memories[i].cache_size > 0))
+	{
+	  sb_fprintf(stdout, "Error: a dram window of %u does not apply behind a cache\n"
+		     , memories[i].window);
+	  return false;
+	}
+    }
+  // same geometry rules as the simple_bus_cache constructor
+  for (unsigned int i = 0; i < memories.size(); ++i)
+    {
+      const simple_bus_memory_config &memory = memories[i];
+      if (memory.cache_size == 0)
+	continue;
+      unsigned int set_size = memory.cache_line * memory.cache_ways;
+      unsigned int nr_sets = memory.cache_size / set_size;
+      if ((memory.cache_line < memory.data_width) || (nr_sets == 0) ||
+	  (nr_sets * set_size != memory.cache_size) || (nr_sets & (nr_sets - 1)))
+	{
+	  sb_fprintf(stdout, "Error: cache of %u bytes, %u ways, lines of %u bytes"
+		     " does not fit a memory of data width %u\n"
+		     , memory.cache_size, memory.cache_ways, memory.cache_line
+		     , memory.data_width);
+	  return false;
+	}
+    }
+  return true;
+}
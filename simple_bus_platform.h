@@ -0,0 +1,218 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_platform.h : Description of a test platform.
+
+		 simple_bus_test builds its masters, memories, bus and
+		 arbiter from a simple_bus_platform_config. The default
+		 configuration is the original test bench; a configuration
+		 file and command line settings change it, so topology
+		 sweeps need no recompilation.
+
+		 The file format is INI style, '#' or ';' start a comment:
+
+		   [platform]            clock (ns), duration (ns),
+		                         metrics (JSON file written at the end),
+		                         restore (snapshot loaded at the start),
+		                         snapshot (written at the end),
+		                         sample_window (clock periods, 0:
+		                         no simple_bus_sampler),
+		                         samples_csv, samples_vcd (time
+		                         series written at the end)
+		   [bus]                 type (shared: simple_bus, crossbar:
+		                         simple_bus_crossbar, 32 bits wide,
+		                         without split, posted_writes,
+		                         trace and snapshots),
+		                         data_width, verbose, split, trace,
+		                         posted_writes (FIFO depth, 0: off),
+		                         arbiter (standard, fast: the bit-set
+		                         arbiter, priority policy only)
+		   [arbiter]             policy (priority, round-robin,
+		                         weighted, tdma), tdma_slot (ns), verbose
+		   [master]              type (blocking, non_blocking, direct,
+		                         lt), count, name, priority, address,
+		                         stride, lock, timeout, weight, verbose
+		   [memory]              type (fast, slow, clockless, dram),
+		                         count,
+		                         name, start, size, wait_states,
+		                         data_width, image (file mapped as
+		                         contents), shared (writes go to
+		                         the image), cache_size (bytes, 0:
+		                         no cache), cache_line, cache_ways,
+		                         cache_policy (write-back,
+		                         write-through), cache_hit and
+		                         cache_miss (wait states); dram:
+		                         banks, row_size (bytes), trcd,
+		                         tcas, trp (wait states), window
+		                         (queue entries, the outstanding
+		                         depth in split mode; 1 behind
+		                         a cache)
+
+		 Every [master] and [memory] section adds count instances;
+		 instance i gets priority+i and address+i*stride (start+i*size
+		 for memories). The first [master] or [memory] section drops
+		 the default ones. On the command line, section.key=value sets
+		 one key of [platform], [bus] or [arbiter], and
+		 master=key=value,... or memory=key=value,... adds a section.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#ifndef __simple_bus_platform_h
+#define __simple_bus_platform_h
+
+#include <string>
+#include <vector>
+
+#include "simple_bus_arbiter.h"
+#include "simple_bus_cache.h"
+
+enum simple_bus_master_type { SIMPLE_BUS_MASTER_BLOCKING = 0
+			      , SIMPLE_BUS_MASTER_NON_BLOCKING
+			      , SIMPLE_BUS_MASTER_DIRECT
+			      , SIMPLE_BUS_MASTER_LT
+};
+
+enum simple_bus_memory_type { SIMPLE_BUS_MEMORY_FAST = 0
+			      , SIMPLE_BUS_MEMORY_SLOW
+			      , SIMPLE_BUS_MEMORY_CLOCKLESS
+			      , SIMPLE_BUS_MEMORY_DRAM
+};
+
+enum simple_bus_bus_type { SIMPLE_BUS_BUS_SHARED = 0 // simple_bus
+			   , SIMPLE_BUS_BUS_CROSSBAR      // simple_bus_crossbar
+};
+
+enum simple_bus_arbiter_type { SIMPLE_BUS_ARBITER_STANDARD = 0 // simple_bus_arbiter
+			       , SIMPLE_BUS_ARBITER_FAST            // simple_bus_fast_arbiter
+};
+
+extern const char *simple_bus_bus_type_str[2];
+extern const char *simple_bus_arbiter_type_str[2];
+extern const char *simple_bus_master_type_str[4];
+extern const char *simple_bus_memory_type_str[4];
+
+// one [master] section
+struct simple_bus_master_config
+{
+  simple_bus_master_type type;
+  unsigned int count;
+  std::string name;            // "" : master_b, master_nb, master_d, master_lt
+  unsigned int priority;       // of the first instance
+  unsigned int address;        // of the first instance
+  unsigned int stride;         // address step between instances
+  bool lock;
+  int timeout;                 // ns between transfers
+  unsigned int weight;         // SIMPLE_BUS_ARB_WEIGHTED
+  bool verbose;                // direct masters only
+};
+
+// one [memory] section
+struct simple_bus_memory_config
+{
+  simple_bus_memory_type type;
+  unsigned int count;
+  std::string name;            // "" : mem_fast, mem_slow, mem_clockless, mem_dram
+  unsigned int start_address;  // of the first instance
+  unsigned int size;           // bytes per instance
+  unsigned int nr_wait_states;
+  unsigned int data_width;
+  std::string image;           // "" : none; mapped by every instance
+  bool shared;                 // count must be 1
+  unsigned int cache_size;     // 0 : no simple_bus_cache in front
+  unsigned int cache_line;
+  unsigned int cache_ways;
+  simple_bus_cache_policy cache_policy;
+  unsigned int cache_hit_wait_states;
+  unsigned int cache_miss_wait_states;
+  unsigned int nr_banks;       // SIMPLE_BUS_MEMORY_DRAM
+  unsigned int row_size;
+  unsigned int trcd;
+  unsigned int tcas;
+  unsigned int trp;
+  unsigned int window;
+};
+
+struct simple_bus_platform_config
+{
+  // the original test bench
+  simple_bus_platform_config();
+
+  // read a configuration file; false (and a message) on errors
+  bool read_file(const char *file_name);
+
+  // command line: [-f file] [section.key=value] [master=...] [memory=...]
+  bool parse_arguments(int argc, char *argv[]);
+  static void usage(const char *program);
+
+  // every master priority is unique and shared images are not mapped
+  // twice nor restored into; parse_arguments checks this too
+  bool check() const;
+
+  // one setting; section is platform, bus, arbiter, master or memory,
+  // the latter two apply to the last section added
+  bool set(const std::string &section, const std::string &key
+	   , const std::string &value);
+  void add_master();
+  void add_memory();
+
+  // platform
+  double clock_period;         // ns
+  double duration;             // ns
+  std::string metrics_file;
+  std::string restore_file;
+  std::string snapshot_file;
+  unsigned int sample_window;  // clock periods, 0 : no sampler
+  std::string samples_csv_file;
+  std::string samples_vcd_file;
+
+  // bus
+  simple_bus_bus_type bus_type;
+  unsigned int data_width;
+  bool bus_verbose;
+  bool split_transactions;
+  unsigned int posted_writes;  // 0 : writes are not posted
+  std::string trace_file;
+  simple_bus_arbiter_type arbiter;
+
+  // arbiter
+  simple_bus_arbiter_policy policy;
+  double tdma_slot;            // ns, 0 : one clock period
+  bool arbiter_verbose;
+
+  std::vector<simple_bus_master_config> masters;
+  std::vector<simple_bus_memory_config> memories;
+
+private:
+  bool m_default_masters;
+  bool m_default_memories;
+};
+
+#endif
@@ -0,0 +1,122 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_quantum_keeper.h : Local time of a loosely-timed master.
+
+		 A master running ahead of the kernel accumulates its
+		 local time here and calls sync() (a wait for the local
+		 time) once need_sync() reports that the global quantum
+		 is used up. A larger quantum means fewer context
+		 switches and a coarser interleaving of the masters.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#ifndef __simple_bus_quantum_keeper_h
+#define __simple_bus_quantum_keeper_h
+
+#include <systemc.h>
+
+class simple_bus_quantum_keeper
+{
+public:
+  // constructor
+  simple_bus_quantum_keeper()
+    : m_local_time(SC_ZERO_TIME)
+  {}
+
+  // the quantum shared by all masters (default 1 us)
+  static void set_global_quantum(const sc_time &quantum);
+  static const sc_time &get_global_quantum();
+
+  void inc(const sc_time &t);
+  void set(const sc_time &t);
+  const sc_time &get_local_time() const;
+  sc_time get_current_time() const;
+
+  bool need_sync() const;
+  void sync();
+
+private:
+  static sc_time &global_quantum();
+
+  sc_time m_local_time; // offset to sc_time_stamp()
+
+}; // end class simple_bus_quantum_keeper
+
+inline sc_time &simple_bus_quantum_keeper::global_quantum()
+{
+  static sc_time quantum(1, SC_US);
+  return quantum;
+}
+
+inline void simple_bus_quantum_keeper::set_global_quantum(const sc_time &quantum)
+{
+  global_quantum() = quantum;
+}
+
+inline const sc_time &simple_bus_quantum_keeper::get_global_quantum()
+{
+  return global_quantum();
+}
+
+inline void simple_bus_quantum_keeper::inc(const sc_time &t)
+{
+  m_local_time += t;
+}
+
+inline void simple_bus_quantum_keeper::set(const sc_time &t)
+{
+  m_local_time = t;
+}
+
+inline const sc_time &simple_bus_quantum_keeper::get_local_time() const
+{
+  return m_local_time;
+}
+
+inline sc_time simple_bus_quantum_keeper::get_current_time() const
+{
+  return sc_time_stamp() + m_local_time;
+}
+
+inline bool simple_bus_quantum_keeper::need_sync() const
+{
+  return m_local_time >= global_quantum();
+}
+
+inline void simple_bus_quantum_keeper::sync()
+{
+  // must be called from a thread process
+  wait(m_local_time);
+  m_local_time = SC_ZERO_TIME;
+}
+
+#endif
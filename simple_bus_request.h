@@ -38,6 +38,9 @@
 #ifndef __simple_bus_request_h
 #define __simple_bus_request_h
 
+#include <map>
+#include <vector>
+
 enum simple_bus_lock_status { SIMPLE_BUS_LOCK_NO = 0
 			      , SIMPLE_BUS_LOCK_SET
 			      , SIMPLE_BUS_LOCK_GRANTED 
@@ -47,17 +50,22 @@ struct simple_bus_request
 {
   // parameters
   unsigned int priority;
+  unsigned int slot; // index in the request list of the bus
 
   // request parameters
   bool do_write;
   unsigned int address;
+  unsigned int start_address; // address as posted (address advances)
   unsigned int end_address;
   int *data;
+  unsigned int byte_enable; // strobes applied to every word (write)
   simple_bus_lock_status lock;
 
   // request status
   sc_event transfer_done;
   simple_bus_status status;
+  unsigned int wait_cycles; // cycles the slave answered SIMPLE_BUS_WAIT
+  sc_time post_time;        // when the master posted the request
 
   // default constructor
   simple_bus_request();
@@ -65,12 +73,55 @@ struct simple_bus_request
 
 inline simple_bus_request::simple_bus_request()
   : priority(0)
+  , slot(0)
   , do_write(false)
   , address(0)
+  , start_address(0)
   , end_address(0)
   , data((int *)0)
+  , byte_enable(SIMPLE_BUS_WORD_ENABLE)
   , lock(SIMPLE_BUS_LOCK_NO)
   , status(SIMPLE_BUS_OK)
+  , wait_cycles(0)
 {}
 
+// priority -> request form. Priorities below SIMPLE_BUS_DENSE_PRIORITIES
+// index a dense table, larger ones go to a sorted map, so an unusual
+// priority value never sizes the table.
+const unsigned int SIMPLE_BUS_DENSE_PRIORITIES = 256;
+
+class simple_bus_request_index
+{
+public:
+  simple_bus_request *find(unsigned int priority) const;
+  void insert(simple_bus_request *request);
+
+private:
+  std::vector<simple_bus_request *> m_dense;
+  std::map<unsigned int, simple_bus_request *> m_sparse;
+};
+
+inline simple_bus_request *simple_bus_request_index::find(unsigned int priority) const
+{
+  if (priority < SIMPLE_BUS_DENSE_PRIORITIES)
+    return (priority < m_dense.size()) ? m_dense[priority]
+                                       : (simple_bus_request *)0;
+  std::map<unsigned int, simple_bus_request *>::const_iterator it =
+    m_sparse.find(priority);
+  return (it != m_sparse.end()) ? it->second : (simple_bus_request *)0;
+}
+
+inline void simple_bus_request_index::insert(simple_bus_request *request)
+{
+  unsigned int priority = request->priority;
+  if (priority < SIMPLE_BUS_DENSE_PRIORITIES)
+    {
+      if (priority >= m_dense.size())
+        m_dense.resize(priority + 1, (simple_bus_request *)0);
+      m_dense[priority] = request;
+    }
+  else
+    m_sparse[priority] = request;
+}
+
 #endif
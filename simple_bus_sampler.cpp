@@ -0,0 +1,143 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_sampler.cpp : Windowed utilization and throughput sampler.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#include "simple_bus_sampler.h"
+
+void simple_bus_sampler::sample()
+{
+  next_trigger(m_window);
+
+  uint64_t active_time = m_metrics.active_time.get();
+  uint64_t bytes = m_metrics.bytes_transferred.get();
+  uint64_t transactions = m_metrics.transactions.get();
+  uint64_t rejections = m_metrics.arbitration_rejections.get();
+
+  if (m_started)
+    {
+      if (m_samples.size() < m_max_windows)
+	{
+	  double window_sec = m_window.to_seconds();
+	  double window_ps = window_sec * 1e12;
+	  simple_bus_sample s;
+	  s.start = sc_time_stamp() - m_window;
+	  s.utilization = (active_time - m_last_active_time) / window_ps;
+	  s.bytes_per_second = (bytes - m_last_bytes) / window_sec;
+	  s.transactions_per_second = (transactions - m_last_transactions) / window_sec;
+	  s.rejections = rejections - m_last_rejections;
+	  m_samples.push_back(s);
+	}
+      else
+	m_dropped++;
+    }
+  m_started = true;
+
+  m_last_active_time = active_time;
+  m_last_bytes = bytes;
+  m_last_transactions = transactions;
+  m_last_rejections = rejections;
+}
+
+void simple_bus_sampler::end_of_simulation()
+{
+  sb_fprintf(stdout, "Muestreo %s: %u ventanas de %s",
+	     name(), (unsigned int)m_samples.size(), m_window.to_string().c_str());
+  if (m_dropped > 0)
+    sb_fprintf(stdout, ", %lu descartadas (serie truncada, capacidad %u)",
+	       m_dropped, m_max_windows);
+  sb_fprintf(stdout, "\n");
+}
+
+const std::vector<simple_bus_sample> &simple_bus_sampler::samples() const
+{
+  return m_samples;
+}
+
+unsigned long simple_bus_sampler::dropped() const
+{
+  return m_dropped;
+}
+
+bool simple_bus_sampler::write_csv(const char *file_name) const
+{
+  FILE *file = fopen(file_name, "w");
+  if (!file)
+    return false;
+  // a truncated series must not look complete
+  if (m_dropped > 0)
+    fprintf(file, "# %lu windows dropped after the first %u\n",
+	    m_dropped, (unsigned int)m_samples.size());
+  fprintf(file, "start_ps,utilization,bytes_per_second,transactions_per_second,rejections\n");
+  for (unsigned int i = 0; i < m_samples.size(); ++i)
+    {
+      const simple_bus_sample &s = m_samples[i];
+      fprintf(file, "%llu,%.4f,%.2f,%.2f,%llu\n",
+	      (unsigned long long)sb_time_ps(s.start), s.utilization,
+	      s.bytes_per_second, s.transactions_per_second,
+	      (unsigned long long)s.rejections);
+    }
+  fclose(file);
+  return true;
+}
+
+bool simple_bus_sampler::write_vcd(const char *file_name) const
+{
+  FILE *file = fopen(file_name, "w");
+  if (!file)
+    return false;
+
+  // one analog trace per quantity, changing at the window boundaries
+  fprintf(file, "$timescale 1 ps $end\n");
+  if (m_dropped > 0)
+    fprintf(file, "$comment %lu windows dropped after the first %u $end\n",
+	    m_dropped, (unsigned int)m_samples.size());
+  fprintf(file, "$scope module %s $end\n", m_metrics.name().c_str());
+  fprintf(file, "$var real 64 u utilization $end\n");
+  fprintf(file, "$var real 64 b bytes_per_second $end\n");
+  fprintf(file, "$var real 64 t transactions_per_second $end\n");
+  fprintf(file, "$var real 64 r rejections $end\n");
+  fprintf(file, "$upscope $end\n");
+  fprintf(file, "$enddefinitions $end\n");
+  for (unsigned int i = 0; i < m_samples.size(); ++i)
+    {
+      const simple_bus_sample &s = m_samples[i];
+      fprintf(file, "#%llu\n", (unsigned long long)sb_time_ps(s.start));
+      fprintf(file, "r%.6g u\n", s.utilization);
+      fprintf(file, "r%.6g b\n", s.bytes_per_second);
+      fprintf(file, "r%.6g t\n", s.transactions_per_second);
+      fprintf(file, "r%llu r\n", (unsigned long long)s.rejections);
+    }
+  fclose(file);
+  return true;
+}
@@ -0,0 +1,119 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_sampler.h : Windowed utilization and throughput sampler.
+
+		 Every window (e.g. N clock periods) the sampler takes
+		 the difference of the counters of a bus since the
+		 previous window: utilization, bytes/s, transactions/s
+		 and arbitration rejections. The samples go into a time
+		 series allocated up front; windows beyond its capacity
+		 are counted but not kept. The series can be written as
+		 CSV or as a VCD file with one analog (real) trace per
+		 quantity. A truncated series says so: the number of
+		 dropped windows goes into a comment of both files and
+		 into the end-of-simulation report.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#ifndef __simple_bus_sampler_h
+#define __simple_bus_sampler_h
+
+#include <systemc.h>
+#include <vector>
+
+#include "simple_bus_types.h"
+#include "simple_bus_metrics.h"
+
+struct simple_bus_sample
+{
+  sc_time start;                   // begin of the window
+  double utilization;              // fraction of the window the bus was busy
+  double bytes_per_second;
+  double transactions_per_second;
+  uint64_t rejections;             // arbitration rejections in the window
+};
+
+class simple_bus_sampler
+  : public sc_module
+{
+public:
+  // constructor
+  simple_bus_sampler(sc_module_name name_
+		     , const simple_bus_metrics &metrics
+		     , const sc_time &window
+		     , unsigned int max_windows = 4096)
+    : sc_module(name_)
+    , m_metrics(metrics)
+    , m_window(window)
+    , m_max_windows(max_windows)
+    , m_dropped(0)
+    , m_started(false)
+    , m_last_active_time(0)
+    , m_last_bytes(0)
+    , m_last_transactions(0)
+    , m_last_rejections(0)
+  {
+    sc_assert(m_window > SC_ZERO_TIME);
+    m_samples.reserve(m_max_windows);
+
+    // process declaration: runs at time 0 and then every window
+    SC_METHOD(sample);
+  }
+
+  // process
+  void sample();
+
+  void end_of_simulation();
+
+  const std::vector<simple_bus_sample> &samples() const;
+  unsigned long dropped() const;
+
+  bool write_csv(const char *file_name) const;
+  bool write_vcd(const char *file_name) const;
+
+private:
+  const simple_bus_metrics &m_metrics;
+  sc_time m_window;
+  unsigned int m_max_windows;
+  std::vector<simple_bus_sample> m_samples;
+  unsigned long m_dropped;
+
+  // counter values at the start of the current window
+  bool m_started;
+  uint64_t m_last_active_time;
+  uint64_t m_last_bytes;
+  uint64_t m_last_transactions;
+  uint64_t m_last_rejections;
+
+}; // end class simple_bus_sampler
+
+#endif
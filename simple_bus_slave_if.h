@@ -52,6 +52,39 @@ public:
   virtual simple_bus_status read(int *data, unsigned int address) = 0;
   virtual simple_bus_status write(int *data, unsigned int address) = 0;
 
+  // optional burst entry points: move length consecutive words in one
+  // call. A slave without native burst support returns false, and the
+  // bus falls back to one read/write call per word.
+  virtual bool burst_read(int *data, unsigned int address, unsigned int length)
+  { return false; }
+  virtual bool burst_write(int *data, unsigned int address, unsigned int length)
+  { return false; }
+
+  // wide data path: a slave moves up to data_width() bytes (a power of
+  // two, at least 4) per access. read_beat/write_beat move words
+  // consecutive words (words*4 <= data_width(), not crossing a
+  // data_width() boundary) in one access, with the same wait-state
+  // protocol as read/write; byte_enable holds the strobes of the beat.
+  // The defaults serve a plain 32-bit slave through read/write.
+  virtual unsigned int data_width() const
+  { return 4; }
+  virtual simple_bus_status read_beat(int *data, unsigned int address
+				      , unsigned int words)
+  { return (words == 1) ? read(data, address) : SIMPLE_BUS_ERROR; }
+  virtual simple_bus_status write_beat(int *data, unsigned int address
+				       , unsigned int words
+				       , unsigned int byte_enable)
+  {
+    if ((words == 1) && (byte_enable == SIMPLE_BUS_WORD_ENABLE))
+      return write(data, address);
+    return SIMPLE_BUS_ERROR;
+  }
+
+  // wait states of one access, for loosely-timed transfers that
+  // compute the delay instead of running the protocol
+  virtual unsigned int nr_wait_states() const
+  { return 0; }
+
   virtual unsigned int start_address() const = 0;
   virtual unsigned int end_address() const = 0;
 
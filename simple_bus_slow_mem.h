@@ -41,11 +41,11 @@
 #include <systemc.h>
 
 #include "simple_bus_types.h"
-#include "simple_bus_slave_if.h"
+#include "simple_bus_memory.h"
 
 
 class simple_bus_slow_mem
-  : public simple_bus_slave_if
+  : public simple_bus_memory
   , public sc_module
 {
 public:
@@ -57,10 +57,10 @@ public:
   simple_bus_slow_mem(sc_module_name name_
 		      , unsigned int start_address
 		      , unsigned int end_address
-		      , unsigned int nr_wait_states)
-    : sc_module(name_)
-    , m_start_address(start_address)
-    , m_end_address(end_address)
+		      , unsigned int nr_wait_states
+		      , unsigned int data_width = 4)
+    : simple_bus_memory(start_address, end_address, data_width)
+    , sc_module(name_)
     , m_nr_wait_states(nr_wait_states)
     , m_wait_count(-1)
   {
@@ -68,18 +68,8 @@ public:
     SC_METHOD(wait_loop);
     dont_initialize();
     sensitive << clock.pos();
-
-    sc_assert(m_start_address <= m_end_address);
-    sc_assert((m_end_address-m_start_address+1)%4 == 0);
-    unsigned int size = (m_end_address-m_start_address+1)/4;
-    MEM = new int [size];
-    for (unsigned int i = 0; i < size; ++i)
-      MEM[i] = 0;
   }
 
-  // destructor
-  ~simple_bus_slow_mem();
-
   // process
   void wait_loop();
 
@@ -90,25 +80,22 @@ public:
   // Slave Interface
   simple_bus_status read(int *data, unsigned int address);
   simple_bus_status write(int *data, unsigned int address);
+  unsigned int data_width() const;
+  simple_bus_status read_beat(int *data, unsigned int address
+			      , unsigned int words);
+  simple_bus_status write_beat(int *data, unsigned int address
+			       , unsigned int words, unsigned int byte_enable);
+  unsigned int nr_wait_states() const;
 
   unsigned int start_address() const;
   unsigned int end_address() const;
 
 private:
-  int *MEM;
-  unsigned int m_start_address;
-  unsigned int m_end_address;
   unsigned int m_nr_wait_states;
   int m_wait_count;
 
 }; // end class simple_bus_slow_mem
 
-inline  simple_bus_slow_mem::~simple_bus_slow_mem()
-{
-  if (MEM) delete [] MEM;
-  MEM = (int *)0;
-}
-
 inline void simple_bus_slow_mem::wait_loop()
 {
   if (m_wait_count >= 0) m_wait_count--;
@@ -116,13 +103,13 @@ inline void simple_bus_slow_mem::wait_loop()
 
 inline bool simple_bus_slow_mem::direct_read(int *data, unsigned int address)
 {
-  *data = MEM[(address - m_start_address)/4];
+  *data = MEM.read(address - m_start_address);
   return true;
 }
 
 inline bool simple_bus_slow_mem::direct_write(int *data, unsigned int address)
 {
-  MEM[(address - m_start_address)/4] = *data;
+  MEM.write(address - m_start_address, *data);
   return true;
 }
 
@@ -137,7 +124,7 @@ inline simple_bus_status simple_bus_slow_mem::read(int *data
     }
   if (m_wait_count == 0)
     {
-      *data = MEM[(address - m_start_address)/4];
+      *data = MEM.read(address - m_start_address);
       return SIMPLE_BUS_OK;
     }
   return SIMPLE_BUS_WAIT;
@@ -154,12 +141,59 @@ inline simple_bus_status simple_bus_slow_mem::write(int *data
     }
   if (m_wait_count == 0)
     {
-      MEM[(address - m_start_address)/4] = *data;
+      MEM.write(address - m_start_address, *data);
+      return SIMPLE_BUS_OK;
+    }
+  return SIMPLE_BUS_WAIT;
+}
+
+inline unsigned int simple_bus_slow_mem::data_width() const
+{
+  return m_data_width;
+}
+
+inline simple_bus_status simple_bus_slow_mem::read_beat(int *data
+							, unsigned int address
+							, unsigned int words)
+{
+  // a beat takes the same wait states as a single word
+  sc_assert(words*4 <= m_data_width);
+  if (m_wait_count < 0)
+    {
+      m_wait_count = m_nr_wait_states;
+      return SIMPLE_BUS_WAIT;
+    }
+  if (m_wait_count == 0)
+    {
+      MEM.read(data, address - m_start_address, words);
+      return SIMPLE_BUS_OK;
+    }
+  return SIMPLE_BUS_WAIT;
+}
+
+inline simple_bus_status simple_bus_slow_mem::write_beat(int *data
+							 , unsigned int address
+							 , unsigned int words
+							 , unsigned int byte_enable)
+{
+  sc_assert(words*4 <= m_data_width);
+  if (m_wait_count < 0)
+    {
+      m_wait_count = m_nr_wait_states;
+      return SIMPLE_BUS_WAIT;
+    }
+  if (m_wait_count == 0)
+    {
+      MEM.write_lanes(data, address - m_start_address, words, byte_enable);
       return SIMPLE_BUS_OK;
     }
   return SIMPLE_BUS_WAIT;
 }
 
+inline unsigned int simple_bus_slow_mem::nr_wait_states() const
+{
+  return m_nr_wait_states;
+}
 
 inline unsigned int simple_bus_slow_mem::start_address() const
 {
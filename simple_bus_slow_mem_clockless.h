@@ -0,0 +1,192 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_slow_mem_clockless.h : Slave : The memory (slave) with wait
+                                    states, without a clock process.
+
+		 Behaves like simple_bus_slow_mem, but instead of counting
+		 down the wait states on every rising clock edge, the
+		 first read/write call of an access computes the time at
+		 which the data is ready from sc_time_stamp() and the
+		 clock period. The memory has no process and no clock port.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#ifndef __simple_bus_slow_mem_clockless_h
+#define __simple_bus_slow_mem_clockless_h
+
+#include <systemc.h>
+
+#include "simple_bus_types.h"
+#include "simple_bus_memory.h"
+
+
+class simple_bus_slow_mem_clockless
+  : public simple_bus_memory
+  , public sc_module
+{
+public:
+  // constructor
+  simple_bus_slow_mem_clockless(sc_module_name name_
+				, unsigned int start_address
+				, unsigned int end_address
+				, unsigned int nr_wait_states
+				, const sc_time &clock_period
+				, unsigned int data_width = 4)
+    : simple_bus_memory(start_address, end_address, data_width)
+    , sc_module(name_)
+    , m_nr_wait_states(nr_wait_states)
+    , m_wait_time(clock_period * nr_wait_states)
+    , m_busy(false)
+    , m_ready_time(SC_ZERO_TIME)
+  {}
+
+  // direct Slave Interface
+  bool direct_read(int *data, unsigned int address);
+  bool direct_write(int *data, unsigned int address);
+
+  // Slave Interface
+  simple_bus_status read(int *data, unsigned int address);
+  simple_bus_status write(int *data, unsigned int address);
+  unsigned int data_width() const;
+  simple_bus_status read_beat(int *data, unsigned int address
+			      , unsigned int words);
+  simple_bus_status write_beat(int *data, unsigned int address
+			       , unsigned int words, unsigned int byte_enable);
+  unsigned int nr_wait_states() const;
+
+  unsigned int start_address() const;
+  unsigned int end_address() const;
+
+private:
+  simple_bus_status access();
+
+  unsigned int m_nr_wait_states;
+  sc_time m_wait_time;
+  bool m_busy;
+  sc_time m_ready_time;
+
+}; // end class simple_bus_slow_mem_clockless
+
+inline simple_bus_status simple_bus_slow_mem_clockless::access()
+{
+  // same protocol as the wait-state counter of simple_bus_slow_mem: the
+  // bus calls on every falling edge, the call nr_wait_states clock
+  // periods after the first one completes. A call after that point
+  // starts a new access, as the counter would have run below zero.
+  const sc_time &now = sc_time_stamp();
+  if (!m_busy || (now > m_ready_time))
+    {
+      m_busy = true;
+      m_ready_time = now + m_wait_time;
+      return SIMPLE_BUS_WAIT;
+    }
+  if (now == m_ready_time)
+    return SIMPLE_BUS_OK;
+  return SIMPLE_BUS_WAIT;
+}
+
+inline bool simple_bus_slow_mem_clockless::direct_read(int *data
+						       , unsigned int address)
+{
+  *data = MEM.read(address - m_start_address);
+  return true;
+}
+
+inline bool simple_bus_slow_mem_clockless::direct_write(int *data
+							, unsigned int address)
+{
+  MEM.write(address - m_start_address, *data);
+  return true;
+}
+
+inline simple_bus_status simple_bus_slow_mem_clockless::read(int *data
+							     , unsigned int address)
+{
+  simple_bus_status status = access();
+  if (status == SIMPLE_BUS_OK)
+    *data = MEM.read(address - m_start_address);
+  return status;
+}
+
+inline simple_bus_status simple_bus_slow_mem_clockless::write(int *data
+							      , unsigned int address)
+{
+  simple_bus_status status = access();
+  if (status == SIMPLE_BUS_OK)
+    MEM.write(address - m_start_address, *data);
+  return status;
+}
+
+inline unsigned int simple_bus_slow_mem_clockless::data_width() const
+{
+  return m_data_width;
+}
+
+inline simple_bus_status simple_bus_slow_mem_clockless::read_beat(int *data
+								  , unsigned int address
+								  , unsigned int words)
+{
+  sc_assert(words*4 <= m_data_width);
+  simple_bus_status status = access();
+  if (status == SIMPLE_BUS_OK)
+    MEM.read(data, address - m_start_address, words);
+  return status;
+}
+
+inline simple_bus_status simple_bus_slow_mem_clockless::write_beat(int *data
+								   , unsigned int address
+								   , unsigned int words
+								   , unsigned int byte_enable)
+{
+  sc_assert(words*4 <= m_data_width);
+  simple_bus_status status = access();
+  if (status == SIMPLE_BUS_OK)
+    MEM.write_lanes(data, address - m_start_address, words, byte_enable);
+  return status;
+}
+
+inline unsigned int simple_bus_slow_mem_clockless::nr_wait_states() const
+{
+  return m_nr_wait_states;
+}
+
+inline unsigned int simple_bus_slow_mem_clockless::start_address() const
+{
+  return m_start_address;
+}
+
+inline unsigned int simple_bus_slow_mem_clockless::end_address() const
+{
+  return m_end_address;
+}
+
+#endif
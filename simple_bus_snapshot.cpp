@@ -0,0 +1,170 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_snapshot.cpp : Checkpoint files.
+
+		 Format, host byte order: "SBSS", uint32 version, then per
+		 module a uint32 name length, the name, a uint64 state
+		 length and the state written by save_state.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "simple_bus_types.h"
+#include "simple_bus_snapshot.h"
+
+static const char snapshot_magic[4] = { 'S', 'B', 'S', 'S' };
+static const uint32_t snapshot_version = 1;
+
+// the modules with a state below root, in hierarchy order
+static void collect(sc_object *object, std::vector<sc_object *> &objects)
+{
+  if (dynamic_cast<simple_bus_snapshot_if *>(object))
+    objects.push_back(object);
+  const std::vector<sc_object *> &children = object->get_child_objects();
+  for (unsigned int i = 0; i < children.size(); ++i)
+    collect(children[i], objects);
+}
+
+static std::vector<sc_object *> collect(sc_object *root)
+{
+  std::vector<sc_object *> objects;
+  if (root)
+    collect(root, objects);
+  else
+    {
+      const std::vector<sc_object *> &tops = sc_get_top_level_objects();
+      for (unsigned int i = 0; i < tops.size(); ++i)
+	collect(tops[i], objects);
+    }
+  return objects;
+}
+
+bool simple_bus_snapshot::ready(sc_object *root)
+{
+  std::vector<sc_object *> objects = collect(root);
+  for (unsigned int i = 0; i < objects.size(); ++i)
+    if (!dynamic_cast<simple_bus_snapshot_if *>(objects[i])->snapshot_ready())
+      return false;
+  return true;
+}
+
+bool simple_bus_snapshot::save(const char *file_name, sc_object *root)
+{
+  std::vector<sc_object *> objects = collect(root);
+  for (unsigned int i = 0; i < objects.size(); ++i)
+    if (!dynamic_cast<simple_bus_snapshot_if *>(objects[i])->snapshot_ready())
+      {
+	sb_fprintf(stdout, "Error: %s has a transfer in flight, no snapshot\n"
+		   , objects[i]->name());
+	return false;
+      }
+
+  FILE *file = fopen(file_name, "wb");
+  if (!file)
+    {
+      sb_fprintf(stdout, "Error: cannot open %s\n", file_name);
+      return false;
+    }
+  bool ok = (fwrite(snapshot_magic, sizeof(snapshot_magic), 1, file) == 1) &&
+    (fwrite(&snapshot_version, sizeof(snapshot_version), 1, file) == 1);
+  for (unsigned int i = 0; ok && (i < objects.size()); ++i)
+    {
+      const char *name = objects[i]->name();
+      uint32_t name_length = strlen(name);
+      uint64_t length = 0;
+      ok = (fwrite(&name_length, sizeof(name_length), 1, file) == 1) &&
+	(fwrite(name, name_length, 1, file) == 1);
+      // the state length is filled in afterwards
+      long length_position = ftell(file);
+      ok = ok && (fwrite(&length, sizeof(length), 1, file) == 1) &&
+	dynamic_cast<simple_bus_snapshot_if *>(objects[i])->save_state(file);
+      long end_position = ftell(file);
+      length = end_position - length_position - sizeof(length);
+      ok = ok && (fseek(file, length_position, SEEK_SET) == 0) &&
+	(fwrite(&length, sizeof(length), 1, file) == 1) &&
+	(fseek(file, end_position, SEEK_SET) == 0);
+      if (!ok)
+	sb_fprintf(stdout, "Error: cannot save %s\n", name);
+    }
+  if (fclose(file) != 0)
+    ok = false;
+  return ok;
+}
+
+bool simple_bus_snapshot::restore(const char *file_name)
+{
+  FILE *file = fopen(file_name, "rb");
+  if (!file)
+    {
+      sb_fprintf(stdout, "Error: cannot open %s\n", file_name);
+      return false;
+    }
+  char magic[sizeof(snapshot_magic)];
+  uint32_t version;
+  bool ok = (fread(magic, sizeof(magic), 1, file) == 1) &&
+    (memcmp(magic, snapshot_magic, sizeof(magic)) == 0) &&
+    (fread(&version, sizeof(version), 1, file) == 1) &&
+    (version == snapshot_version);
+  if (!ok)
+    sb_fprintf(stdout, "Error: %s is not a snapshot\n", file_name);
+
+  uint32_t name_length;
+  while (ok && (fread(&name_length, sizeof(name_length), 1, file) == 1))
+    {
+      std::string name(name_length, '\0');
+      uint64_t length;
+      ok = (fread(&name[0], name_length, 1, file) == 1) &&
+	(fread(&length, sizeof(length), 1, file) == 1);
+      if (!ok)
+	break;
+      long start_position = ftell(file);
+      simple_bus_snapshot_if *module =
+	dynamic_cast<simple_bus_snapshot_if *>(sc_find_object(name.c_str()));
+      if (!module)
+	{
+	  sb_fprintf(stdout, "Error: %s not found in this platform\n", name.c_str());
+	  ok = false;
+	}
+      else if (!module->restore_state(file) ||
+	       ((uint64_t)(ftell(file) - start_position) != length))
+	{
+	  sb_fprintf(stdout, "Error: cannot restore %s\n", name.c_str());
+	  ok = false;
+	}
+    }
+  fclose(file);
+  return ok;
+}
@@ -0,0 +1,79 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_snapshot.h : Checkpoints of a platform.
+
+		 Modules with state worth keeping implement
+		 simple_bus_snapshot_if: the memories save their contents,
+		 the bus its request forms (lock states included).
+		 simple_bus_snapshot writes the state of all such modules
+		 below a point of the hierarchy into one file, each under
+		 its hierarchical name, and restores it into a platform
+		 with the same names.
+
+		 A snapshot holds no simulation time and no process state:
+		 the masters start afresh in the restored platform. The
+		 bus can only be saved between transfers, because a
+		 pending request refers to the buffer of its master; run
+		 the simulation on until ready() holds.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#ifndef __simple_bus_snapshot_h
+#define __simple_bus_snapshot_h
+
+#include <stdio.h>
+#include <systemc.h>
+
+class simple_bus_snapshot_if
+{
+public:
+  // the state can be saved now
+  virtual bool snapshot_ready() const { return true; }
+
+  virtual bool save_state(FILE *file) const = 0;
+  virtual bool restore_state(FILE *file) = 0;
+
+  virtual ~simple_bus_snapshot_if() {}
+
+}; // end class simple_bus_snapshot_if
+
+class simple_bus_snapshot
+{
+public:
+  // root 0 : all top level objects
+  static bool ready(sc_object *root = 0);
+  static bool save(const char *file_name, sc_object *root = 0);
+  static bool restore(const char *file_name);
+
+}; // end class simple_bus_snapshot
+
+#endif
@@ -20,6 +20,10 @@
 /*****************************************************************************
  
   simple_bus_test.h : The test bench.
+
+		 The platform is built from a simple_bus_platform_config,
+		 by default the original bench: a blocking, a non-blocking
+		 and a direct master, a fast and a slow memory.
  
   Original Author: Ric Hilderink, Synopsys, Inc., 2001-10-11
  
@@ -39,14 +43,25 @@
 #define __simple_bus_test_h
 
 #include <systemc.h>
+#include <map>
+#include <string>
+#include <vector>
 
 #include "simple_bus_master_blocking.h"
 #include "simple_bus_master_non_blocking.h"
 #include "simple_bus_master_direct.h"
+#include "simple_bus_master_lt.h"
 #include "simple_bus_slow_mem.h"
+#include "simple_bus_slow_mem_clockless.h"
 #include "simple_bus.h"
+#include "simple_bus_crossbar.h"
 #include "simple_bus_fast_mem.h"
+#include "simple_bus_cache.h"
+#include "simple_bus_dram.h"
 #include "simple_bus_arbiter.h"
+#include "simple_bus_fast_arbiter.h"
+#include "simple_bus_platform.h"
+#include "simple_bus_sampler.h"
 
 SC_MODULE(simple_bus_test)
 {
@@ -54,55 +69,288 @@ SC_MODULE(simple_bus_test)
   sc_clock C1;
 
   // module instances
-  simple_bus_master_blocking     *master_b;
-  simple_bus_master_non_blocking *master_nb;
-  simple_bus_master_direct       *master_d;
-  simple_bus_slow_mem            *mem_slow;
-  simple_bus                     *bus;
-  simple_bus_fast_mem            *mem_fast;
-  simple_bus_arbiter             *arbiter;
+  std::vector<sc_module *> masters;
+  std::vector<sc_module *> memories;
+  simple_bus                     *bus;      // 0 with bus.type = crossbar
+  simple_bus_crossbar            *crossbar; // 0 otherwise
+  simple_bus_arbiter             *arbiter;      // 0 with bus.arbiter = fast
+  simple_bus_fast_arbiter        *fast_arbiter; // 0 otherwise
+  simple_bus_sampler             *sampler; // 0 without platform.sample_window
 
   // constructor
-  SC_CTOR(simple_bus_test)
-    : C1("C1")
+  simple_bus_test(sc_module_name name_
+		  , const simple_bus_platform_config &config = simple_bus_platform_config())
+    : sc_module(name_)
+    , C1("C1", config.clock_period, SC_NS)
+    , bus(0)
+    , crossbar(0)
+    , arbiter(0)
+    , fast_arbiter(0)
+    , sampler(0)
   {
-    // create instances
-    master_b = new simple_bus_master_blocking("master_b", 4, 0x4c, false, 300);
-    master_nb = new simple_bus_master_non_blocking("master_nb", 3, 0x38, false, 20);
-    master_d = new simple_bus_master_direct("master_d", 0x78, 100);
-    mem_fast = new simple_bus_fast_mem("mem_fast", 0x00, 0x7f);
-    mem_slow = new simple_bus_slow_mem("mem_slow", 0x80, 0xff, 1);
+    // create instances, masters and memories first as in the original
+    // bench (the order of the processes is the order of creation)
+    std::vector<simple_bus_master_blocking *> masters_b;
+    std::vector<simple_bus_master_non_blocking *> masters_nb;
+    std::vector<simple_bus_master_direct *> masters_d;
+    std::vector<simple_bus_master_lt *> masters_lt;
+    std::vector<unsigned int> priorities;
+    std::vector<unsigned int> weights;
+    for (unsigned int i = 0; i < config.masters.size(); ++i)
+      {
+	const simple_bus_master_config &master = config.masters[i];
+	for (unsigned int j = 0; j < master.count; ++j)
+	  {
+	    unsigned int priority = master.priority + j;
+	    unsigned int address = master.address + j * master.stride;
+	    switch (master.type)
+	      {
+	      case SIMPLE_BUS_MASTER_BLOCKING:
+		masters_b.push_back(new simple_bus_master_blocking
+				    (instance_name(master.name, "master_b").c_str(),
+				     priority, address, master.lock, master.timeout));
+		masters.push_back(masters_b.back());
+		break;
+	      case SIMPLE_BUS_MASTER_NON_BLOCKING:
+		masters_nb.push_back(new simple_bus_master_non_blocking
+				     (instance_name(master.name, "master_nb").c_str(),
+				      priority, address, master.lock, master.timeout));
+		masters.push_back(masters_nb.back());
+		break;
+	      case SIMPLE_BUS_MASTER_DIRECT:
+		masters_d.push_back(new simple_bus_master_direct
+				    (instance_name(master.name, "master_d").c_str(),
+				     address, master.timeout, master.verbose));
+		masters.push_back(masters_d.back());
+		break;
+	      case SIMPLE_BUS_MASTER_LT:
+		masters_lt.push_back(new simple_bus_master_lt
+				     (instance_name(master.name, "master_lt").c_str(),
+				      address, master.timeout, C1.period()));
+		masters.push_back(masters_lt.back());
+		break;
+	      }
+	    if ((master.type == SIMPLE_BUS_MASTER_BLOCKING) ||
+		(master.type == SIMPLE_BUS_MASTER_NON_BLOCKING))
+	      {
+		priorities.push_back(priority);
+		weights.push_back(master.weight);
+	      }
+	  }
+      }
+
+    std::vector<simple_bus_slave_if *> slaves;
+    std::vector<simple_bus_slow_mem *> mems_slow;
+    std::vector<simple_bus_dram *> mems_dram;
+    std::vector<unsigned int> windows;
+    for (unsigned int i = 0; i < config.memories.size(); ++i)
+      {
+	const simple_bus_memory_config &memory = config.memories[i];
+	for (unsigned int j = 0; j < memory.count; ++j)
+	  {
+	    unsigned int start_address = memory.start_address + j * memory.size;
+	    unsigned int end_address = start_address + memory.size - 1;
+	    switch (memory.type)
+	      {
+	      case SIMPLE_BUS_MEMORY_FAST:
+		{
+		  simple_bus_fast_mem *mem_fast = new simple_bus_fast_mem
+		    (instance_name(memory.name, "mem_fast").c_str(),
+		     start_address, end_address, memory.data_width);
+		  if (!memory.image.empty())
+		    map_image(mem_fast, memory);
+		  slaves.push_back(mem_fast);
+		  memories.push_back(mem_fast);
+		  break;
+		}
+	      case SIMPLE_BUS_MEMORY_SLOW:
+		{
+		  simple_bus_slow_mem *mem_slow = new simple_bus_slow_mem
+		    (instance_name(memory.name, "mem_slow").c_str(),
+		     start_address, end_address, memory.nr_wait_states, memory.data_width);
+		  if (!memory.image.empty())
+		    map_image(mem_slow, memory);
+		  mems_slow.push_back(mem_slow);
+		  slaves.push_back(mem_slow);
+		  memories.push_back(mem_slow);
+		  break;
+		}
+	      case SIMPLE_BUS_MEMORY_CLOCKLESS:
+		{
+		  simple_bus_slow_mem_clockless *mem_clockless = new simple_bus_slow_mem_clockless
+		    (instance_name(memory.name, "mem_clockless").c_str(),
+		     start_address, end_address, memory.nr_wait_states, C1.period(),
+		     memory.data_width);
+		  if (!memory.image.empty())
+		    map_image(mem_clockless, memory);
+		  slaves.push_back(mem_clockless);
+		  memories.push_back(mem_clockless);
+		  break;
+		}
+	      case SIMPLE_BUS_MEMORY_DRAM:
+		{
+		  simple_bus_dram *mem_dram = new simple_bus_dram
+		    (instance_name(memory.name, "mem_dram").c_str(),
+		     start_address, end_address, memory.nr_banks, memory.row_size,
+		     memory.trcd, memory.tcas, memory.trp, memory.window, C1.period(),
+		     memory.data_width);
+		  if (!memory.image.empty())
+		    map_image(mem_dram, memory);
+		  // the bus sees the dram itself only without a cache
+		  if (memory.cache_size == 0)
+		    {
+		      mems_dram.push_back(mem_dram);
+		      windows.push_back(memory.window);
+		    }
+		  slaves.push_back(mem_dram);
+		  memories.push_back(mem_dram);
+		  break;
+		}
+	      }
+	    if (memory.cache_size > 0)
+	      add_cache(slaves, memory);
+	  }
+      }
+
     // bus = new simple_bus("bus",true); // verbose output
-    bus = new simple_bus("bus");
+    if (config.bus_type == SIMPLE_BUS_BUS_CROSSBAR)
+      crossbar = new simple_bus_crossbar("bus", config.bus_verbose);
+    else
+      {
+	bus = new simple_bus("bus", config.bus_verbose, config.data_width);
+	bus->set_split_transactions(config.split_transactions);
+	bus->set_posted_writes(config.posted_writes);
+	// a dram reorders as many accesses as the bus parks at it
+	for (unsigned int i = 0; i < mems_dram.size(); ++i)
+	  if (windows[i] > 1)
+	    bus->set_outstanding_depth(mems_dram[i], windows[i]);
+	if (!config.trace_file.empty())
+	  bus->trace_transactions(config.trace_file.c_str());
+      }
+    if (config.sample_window > 0)
+      sampler = new simple_bus_sampler("sampler", bus ? bus->metrics() : crossbar->metrics(),
+				       C1.period() * (double)config.sample_window);
     // arbiter = new simple_bus_arbiter("arbiter",true); // verbose output
-    arbiter = new simple_bus_arbiter("arbiter");
+    if (config.arbiter == SIMPLE_BUS_ARBITER_FAST)
+      fast_arbiter = new simple_bus_fast_arbiter("arbiter", config.arbiter_verbose);
+    else
+      {
+	arbiter = new simple_bus_arbiter("arbiter", config.arbiter_verbose, config.policy);
+	for (unsigned int i = 0; i < priorities.size(); ++i)
+	  arbiter->set_weight(priorities[i], weights[i]);
+	if (!priorities.empty())
+	  arbiter->set_tdma_table(priorities, (config.tdma_slot > 0.0) ?
+				  sc_time(config.tdma_slot, SC_NS) : C1.period());
+      }
 
     // connect instances
-    master_d->clock(C1);
-    bus->clock(C1);
-    master_b->clock(C1);
-    master_nb->clock(C1);
-    mem_slow->clock(C1);
-    master_d->bus_port(*bus);
-    master_b->bus_port(*bus);
-    master_nb->bus_port(*bus);
-    bus->arbiter_port(*arbiter);
-    bus->slave_port(*mem_slow);
-    bus->slave_port(*mem_fast);
+    if (bus)
+      connect(bus, masters_b, masters_nb, masters_d, masters_lt, mems_slow, slaves);
+    else
+      connect(crossbar, masters_b, masters_nb, masters_d, masters_lt, mems_slow, slaves);
   }
 
   // destructor
   ~simple_bus_test()
   {
-    if (master_b) {delete master_b; master_b = 0;}
-    if (master_nb) {delete master_nb; master_nb = 0;}
-    if (master_d) {delete master_d; master_d = 0;}
-    if (mem_slow) {delete mem_slow; mem_slow = 0;}
+    for (unsigned int i = 0; i < masters.size(); ++i)
+      delete masters[i];
+    for (unsigned int i = 0; i < memories.size(); ++i)
+      delete memories[i];
     if (bus) {delete bus; bus = 0;}
-    if (mem_fast) {delete mem_fast; mem_fast = 0;}
+    if (crossbar) {delete crossbar; crossbar = 0;}
     if (arbiter) {delete arbiter; arbiter = 0;}
+    if (fast_arbiter) {delete fast_arbiter; fast_arbiter = 0;}
+    if (sampler) {delete sampler; sampler = 0;}
+  }
+
+  // utilization report of the bus or of the crossbar
+  void report_bus_utilization()
+  {
+    if (bus)
+      bus->report_bus_utilization();
+    else
+      crossbar->report_bus_utilization();
   }
 
+private:
+  // simple_bus and simple_bus_crossbar have the same ports and master
+  // interfaces
+  template <class B>
+  void connect(B *b
+	       , const std::vector<simple_bus_master_blocking *> &masters_b
+	       , const std::vector<simple_bus_master_non_blocking *> &masters_nb
+	       , const std::vector<simple_bus_master_direct *> &masters_d
+	       , const std::vector<simple_bus_master_lt *> &masters_lt
+	       , const std::vector<simple_bus_slow_mem *> &mems_slow
+	       , const std::vector<simple_bus_slave_if *> &slaves)
+  {
+    for (unsigned int i = 0; i < masters_d.size(); ++i)
+      {
+	masters_d[i]->clock(C1);
+	masters_d[i]->bus_port(*b);
+      }
+    b->clock(C1);
+    for (unsigned int i = 0; i < masters_b.size(); ++i)
+      {
+	masters_b[i]->clock(C1);
+	masters_b[i]->bus_port(*b);
+      }
+    for (unsigned int i = 0; i < masters_nb.size(); ++i)
+      {
+	masters_nb[i]->clock(C1);
+	masters_nb[i]->bus_port(*b);
+      }
+    for (unsigned int i = 0; i < masters_lt.size(); ++i)
+      masters_lt[i]->bus_port(*b);
+    for (unsigned int i = 0; i < mems_slow.size(); ++i)
+      mems_slow[i]->clock(C1);
+    if (arbiter)
+      b->arbiter_port(*arbiter);
+    else
+      b->arbiter_port(*fast_arbiter);
+    for (unsigned int i = 0; i < slaves.size(); ++i)
+      b->slave_port(*slaves[i]);
+  }
+
+  template <class T>
+  void map_image(T *memory, const simple_bus_memory_config &config)
+  {
+    if (!memory->map_file(config.image.c_str(), config.shared))
+      {
+	sb_fprintf(stdout, "Error: cannot map %s into %s\n"
+		   , config.image.c_str(), memory->name());
+	exit(1);
+      }
+  }
+
+  // puts a cache between the bus and the memory created last
+  void add_cache(std::vector<simple_bus_slave_if *> &slaves
+		 , const simple_bus_memory_config &config)
+  {
+    simple_bus_cache *cache = new simple_bus_cache
+      ((std::string(memories.back()->basename()) + "_cache").c_str(),
+       config.cache_size, config.cache_line, config.cache_ways, config.cache_policy,
+       config.cache_hit_wait_states, config.cache_miss_wait_states, C1.period());
+    cache->backend_port(*slaves.back());
+    slaves.back() = cache;
+    memories.push_back(cache);
+  }
+
+  // the configured or default name; repeated names get _1, _2, ...
+  std::string instance_name(const std::string &name, const char *default_name)
+  {
+    std::string base = name.empty() ? std::string(default_name) : name;
+    unsigned int uses = m_name_uses[base]++;
+    if (uses == 0)
+      return base;
+    char suffix[16];
+    sprintf(suffix, "_%u", uses);
+    return base + suffix;
+  }
+
+  std::map<std::string, unsigned int> m_name_uses;
+
 }; // end class simple_bus_test
 
 #endif
@@ -0,0 +1,150 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_trace.cpp : The transaction recorder.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#include <string.h>
+#include <chrono>
+
+#include "simple_bus_trace.h"
+
+// the writer is woken every batch records, and polls meanwhile
+static const unsigned long long simple_bus_trace_batch = 1024;
+
+simple_bus_trace_recorder::simple_bus_trace_recorder()
+  : m_file((FILE *)0)
+  , m_mask(0)
+  , m_head(0)
+  , m_tail(0)
+  , m_closing(false)
+{}
+
+simple_bus_trace_recorder::~simple_bus_trace_recorder()
+{
+  close();
+}
+
+bool simple_bus_trace_recorder::open(const char *file_name, unsigned int capacity)
+{
+  close();
+  m_file = fopen(file_name, "wb");
+  if (!m_file)
+    return false;
+
+  simple_bus_trace_file_header header;
+  memcpy(header.magic, SIMPLE_BUS_TRACE_MAGIC, 4);
+  header.version = SIMPLE_BUS_TRACE_VERSION;
+  header.record_size = sizeof(simple_bus_trace_record);
+  header.reserved = 0;
+  fwrite(&header, sizeof(header), 1, m_file);
+
+  unsigned long long size = simple_bus_trace_batch;
+  while (size < capacity)
+    size <<= 1;
+  m_ring.resize(size);
+  m_mask = size - 1;
+  m_head = 0;
+  m_tail = 0;
+  m_closing = false;
+  m_writer = std::thread(&simple_bus_trace_recorder::writer_loop, this);
+  return true;
+}
+
+void simple_bus_trace_recorder::close()
+{
+  if (!m_file)
+    return;
+  m_closing.store(true, std::memory_order_release);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_data_ready.notify_one();
+  }
+  m_writer.join();
+  fclose(m_file);
+  m_file = (FILE *)0;
+}
+
+bool simple_bus_trace_recorder::is_open() const
+{
+  return m_file != (FILE *)0;
+}
+
+void simple_bus_trace_recorder::record(const simple_bus_trace_record &record)
+{
+  unsigned long long tail = m_tail.load(std::memory_order_relaxed);
+  if (tail - m_head.load(std::memory_order_acquire) == m_ring.size())
+    {
+      // the writer is a whole ring behind: wait for room
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_data_ready.notify_one();
+      m_room_ready.wait(lock, [&] {
+	  return tail - m_head.load(std::memory_order_acquire) < m_ring.size();
+	});
+    }
+  m_ring[tail & m_mask] = record;
+  m_tail.store(tail + 1, std::memory_order_release);
+  if (((tail + 1) % simple_bus_trace_batch) == 0)
+    m_data_ready.notify_one();
+}
+
+void simple_bus_trace_recorder::writer_loop()
+{
+  while (true)
+    {
+      // read the closing flag before the tail: once it is set, the
+      // tail read after it is final
+      bool closing = m_closing.load(std::memory_order_acquire);
+      unsigned long long head = m_head.load(std::memory_order_relaxed);
+      unsigned long long tail = m_tail.load(std::memory_order_acquire);
+      if (head == tail)
+	{
+	  if (closing)
+	    break;
+	  std::unique_lock<std::mutex> lock(m_mutex);
+	  m_data_ready.wait_for(lock, std::chrono::milliseconds(10));
+	  continue;
+	}
+
+      // write out the records up to the tail or the end of the ring
+      unsigned long long end = head - (head & m_mask) + m_ring.size();
+      if (end > tail)
+	end = tail;
+      fwrite(&m_ring[head & m_mask], sizeof(simple_bus_trace_record),
+	     (size_t)(end - head), m_file);
+      m_head.store(end, std::memory_order_release);
+
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_room_ready.notify_one();
+    }
+  fflush(m_file);
+}
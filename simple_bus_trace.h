@@ -0,0 +1,88 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_trace.h : The transaction recorder.
+
+		 record() copies a record into a ring buffer and
+		 returns; a writer thread drains the ring to the trace
+		 file in batches. The simulation thread only formats no
+		 text and does no file I/O, it blocks only when the
+		 writer falls a whole ring behind. The ring has a single
+		 producer (the simulation) and a single consumer (the
+		 writer), so its indices are plain atomics.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#ifndef __simple_bus_trace_h
+#define __simple_bus_trace_h
+
+#include <stdio.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "simple_bus_trace_format.h"
+
+class simple_bus_trace_recorder
+{
+public:
+  // constructor
+  simple_bus_trace_recorder();
+
+  // destructor
+  ~simple_bus_trace_recorder();
+
+  // capacity is rounded up to a power of two
+  bool open(const char *file_name, unsigned int capacity = 1 << 16);
+  void close(); // writes out all records and stops the writer
+  bool is_open() const;
+
+  void record(const simple_bus_trace_record &record);
+
+private:
+  void writer_loop();
+
+  FILE *m_file;
+  std::vector<simple_bus_trace_record> m_ring;
+  unsigned long long m_mask;
+  std::atomic<unsigned long long> m_head; // next record to write out
+  std::atomic<unsigned long long> m_tail; // next free slot
+  std::atomic<bool> m_closing;
+  std::mutex m_mutex;
+  std::condition_variable m_data_ready;   // wakes the writer
+  std::condition_variable m_room_ready;   // wakes a blocked record()
+  std::thread m_writer;
+
+}; // end class simple_bus_trace_recorder
+
+#endif
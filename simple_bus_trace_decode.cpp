@@ -0,0 +1,124 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_trace_decode.cpp : Offline decoder of transaction traces.
+
+		 Converts a trace file written by the transaction
+		 recorder of simple_bus to CSV (default) or JSON on
+		 standard output:
+
+		   simple_bus_trace_decode [-json] <trace file>
+
+		 Standalone program, it does not link against SystemC.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "simple_bus_trace_format.h"
+
+// same order as simple_bus_status
+static const char *status_str[] = { "OK", "REQUEST", "WAIT", "ERROR" };
+
+static const char *status_name(unsigned int status)
+{
+  return (status < 4) ? status_str[status] : "?";
+}
+
+int main(int argc, char *argv[])
+{
+  bool json = false;
+  const char *file_name = (const char *)0;
+  for (int i = 1; i < argc; ++i)
+    if (strcmp(argv[i], "-json") == 0)
+      json = true;
+    else
+      file_name = argv[i];
+  if (!file_name)
+    {
+      fprintf(stderr, "usage: %s [-json] <trace file>\n", argv[0]);
+      return 1;
+    }
+
+  FILE *file = fopen(file_name, "rb");
+  if (!file)
+    {
+      fprintf(stderr, "%s: cannot open %s\n", argv[0], file_name);
+      return 1;
+    }
+
+  simple_bus_trace_file_header header;
+  if ((fread(&header, sizeof(header), 1, file) != 1) ||
+      (memcmp(header.magic, SIMPLE_BUS_TRACE_MAGIC, 4) != 0) ||
+      (header.version != SIMPLE_BUS_TRACE_VERSION) ||
+      (header.record_size != sizeof(simple_bus_trace_record)))
+    {
+      fprintf(stderr, "%s: %s is not a simple_bus trace (version %d)\n",
+	      argv[0], file_name, SIMPLE_BUS_TRACE_VERSION);
+      fclose(file);
+      return 1;
+    }
+
+  if (json)
+    printf("[\n");
+  else
+    printf("time_ps,priority,address,length,access,status,wait_cycles\n");
+
+  const unsigned int chunk = 4096;
+  static simple_bus_trace_record records[chunk];
+  unsigned long count = 0;
+  size_t n;
+  while ((n = fread(records, sizeof(simple_bus_trace_record), chunk, file)) > 0)
+    for (size_t i = 0; i < n; ++i, ++count)
+      {
+	const simple_bus_trace_record &r = records[i];
+	if (json)
+	  printf("%s  {\"time_ps\": %llu, \"priority\": %u, \"address\": %u, "
+		 "\"length\": %u, \"access\": \"%s\", \"status\": \"%s\", "
+		 "\"wait_cycles\": %u}",
+		 count ? ",\n" : "", (unsigned long long)r.time_ps,
+		 (unsigned int)r.priority, (unsigned int)r.address,
+		 (unsigned int)r.length, r.do_write ? "write" : "read",
+		 status_name(r.status), (unsigned int)r.wait_cycles);
+	else
+	  printf("%llu,%u,0x%x,%u,%s,%s,%u\n",
+		 (unsigned long long)r.time_ps, (unsigned int)r.priority,
+		 (unsigned int)r.address, (unsigned int)r.length,
+		 r.do_write ? "write" : "read", status_name(r.status),
+		 (unsigned int)r.wait_cycles);
+      }
+
+  if (json)
+    printf("%s]\n", count ? "\n" : "");
+  fclose(file);
+  return 0;
+}
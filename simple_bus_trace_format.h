@@ -0,0 +1,72 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+ 
+  simple_bus_trace_format.h : File format of the transaction trace.
+
+		 A trace file is a simple_bus_trace_file_header followed
+		 by fixed-size simple_bus_trace_record entries, one per
+		 completed (or failed) transaction, in native byte order.
+		 This header does not depend on SystemC, so the offline
+		 decoder builds without it.
+ 
+ *****************************************************************************/
+ 
+/*****************************************************************************
+ 
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+ 
+      Name, Affiliation, Date:
+  Description of Modification:
+ 
+ *****************************************************************************/
+
+#ifndef __simple_bus_trace_format_h
+#define __simple_bus_trace_format_h
+
+#include <stdint.h>
+
+#define SIMPLE_BUS_TRACE_MAGIC   "SBTR"
+#define SIMPLE_BUS_TRACE_VERSION 1
+
+struct simple_bus_trace_file_header
+{
+  char magic[4];         // SIMPLE_BUS_TRACE_MAGIC
+  uint32_t version;      // SIMPLE_BUS_TRACE_VERSION
+  uint32_t record_size;  // sizeof(simple_bus_trace_record)
+  uint32_t reserved;
+};
+
+struct simple_bus_trace_record
+{
+  uint64_t time_ps;      // completion time in ps
+  uint32_t address;      // start address
+  uint32_t length;       // words
+  uint32_t wait_cycles;  // cycles the slave answered SIMPLE_BUS_WAIT
+  uint16_t priority;     // unique priority of the master
+  uint8_t do_write;
+  uint8_t status;        // simple_bus_status
+};
+
+static_assert(sizeof(simple_bus_trace_record) == 24,
+	      "trace records must stay 24 bytes");
+
+#endif
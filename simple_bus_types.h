@@ -41,6 +41,8 @@
 #include <stdio.h>
 #include <systemc.h>
 
+#include "simple_bus_config.h"
+
 enum simple_bus_status { SIMPLE_BUS_OK = 0
 			 , SIMPLE_BUS_REQUEST
 			 , SIMPLE_BUS_WAIT
@@ -54,4 +56,63 @@ typedef std::vector<simple_bus_request *> simple_bus_request_vec;
 
 extern int sb_fprintf(FILE *, const char *, ...);
 
+// index of the lowest set bit of a non-zero word
+inline unsigned int sb_lowest_bit(unsigned long long word)
+{
+#if defined(__GNUC__)
+  return __builtin_ctzll(word);
+#else
+  unsigned int index = 0;
+  while (!(word & 1ULL)) { word >>= 1; ++index; }
+  return index;
+#endif
+}
+
+// byte-lane strobes: bit i enables byte i of a beat, counted from the
+// lowest address, so one 32-bit word uses the low four bits
+const unsigned int SIMPLE_BUS_WORD_ENABLE = 0xFu;
+
+// strobes of a beat of words words, each with the lanes of word_enable
+inline unsigned int sb_beat_enable(unsigned int words, unsigned int word_enable)
+{
+  unsigned int byte_enable = 0;
+  for (unsigned int i = 0; i < words; ++i)
+    byte_enable |= (word_enable & SIMPLE_BUS_WORD_ENABLE) << (4*i);
+  return byte_enable;
+}
+
+// number of set bits, i.e. enabled bytes of a strobe
+inline unsigned int sb_count_bits(unsigned int word)
+{
+#if defined(__GNUC__)
+  return __builtin_popcount(word);
+#else
+  unsigned int count = 0;
+  for (; word; word &= word - 1) ++count;
+  return count;
+#endif
+}
+
+// copies a beat of words words from data to mem, keeping the bytes of
+// mem whose strobe is clear (byte i of a word is bits 8i..8i+7)
+inline void sb_write_lanes(int *mem, const int *data
+			   , unsigned int words, unsigned int byte_enable)
+{
+  for (unsigned int i = 0; i < words; ++i, byte_enable >>= 4)
+    {
+      unsigned int lanes = byte_enable & SIMPLE_BUS_WORD_ENABLE;
+      if (lanes == SIMPLE_BUS_WORD_ENABLE)
+	mem[i] = data[i];
+      else if (lanes)
+	{
+	  unsigned int mask = 0;
+	  for (unsigned int b = 0; b < 4; ++b)
+	    if (lanes & (1u << b))
+	      mask |= 0xFFu << (8*b);
+	  mem[i] = (int)(((unsigned int)mem[i] & ~mask) |
+			 ((unsigned int)data[i] & mask));
+	}
+    }
+}
+
 #endif